@@ -0,0 +1,38 @@
+#include <iostream>
+#include <vector>
+#include <random>
+#include <chrono>
+#include "binary_tree_game.h"
+#include "alpha_beta.h"
+
+int main() {
+    // Example values for leaf nodes (the tree from alpha_beta_pruning.ipynb)
+    std::vector<int> values = {3, 5, 2, 9, 12, 5, 23, 15};
+    int maxDepth = 3; // Depth of the tree
+
+    BinaryTreeGame game(values, maxDepth);
+    AlphaBetaSearch<BinaryTreeGame> search(game);
+    int result = search.search(maxDepth);
+    std::cout << "Optimal value: " << result << " (first move: child " << search.bestMove
+              << ", nodes visited: " << search.nodes << ")" << std::endl;
+
+    // Throughput on a larger random binary tree
+    int benchDepth = 24;
+    std::vector<int> benchValues(1 << benchDepth);
+    std::mt19937 rng(42);
+    for (auto &value : benchValues) {
+        value = static_cast<int>(rng() % 1000);
+    }
+    BinaryTreeGame benchGame(benchValues, benchDepth);
+    AlphaBetaSearch<BinaryTreeGame> benchSearch(benchGame);
+
+    auto start = std::chrono::steady_clock::now();
+    int benchResult = benchSearch.search(benchDepth);
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << "Depth " << benchDepth << " random tree: value " << benchResult << ", "
+              << benchSearch.nodes << " nodes in " << seconds << " s ("
+              << static_cast<long long>(benchSearch.nodes / std::max(seconds, 1e-9)) << " nodes/s)" << std::endl;
+
+    return 0;
+}
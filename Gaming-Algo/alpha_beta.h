@@ -0,0 +1,85 @@
+#ifndef ALPHA_BETA_H
+#define ALPHA_BETA_H
+
+#include <vector>
+#include <algorithm>
+#include "game.h"
+#include "tablebase.h"
+
+// Negamax alpha-beta search over any Game (see game.h).
+// Fail-soft: the returned score may lie outside [alpha, beta], which gives callers a tighter bound.
+// Move lists are kept per ply and reused, so the search does no allocation after warm-up.
+// With a tablebase attached, positions it covers are scored by one lookup instead of a subtree.
+template <typename Game>
+class AlphaBetaSearch {
+public:
+    typedef typename Game::Move Move;
+
+    const Tablebase *tablebase = nullptr; // Optional; needs a Game with perfect indexing
+
+    explicit AlphaBetaSearch(Game &game) : game(game) {}
+
+    // Search the current position to the given depth and return its score
+    int search(int depth) {
+        nodes = 0;
+        bestMove = Move();
+        // One move list per ply, sized up front so references stay valid during recursion
+        if (moveStack.size() < static_cast<size_t>(depth) + 1) {
+            moveStack.resize(depth + 1);
+        }
+        return alphaBeta(depth, 0, -SCORE_INF, SCORE_INF);
+    }
+
+    int alphaBeta(int depth, int ply, int alpha, int beta) {
+        nodes++;
+
+        // Solved position (not at the root, which must still choose a move)
+        TBEntry solved;
+        if (tablebase && ply > 0 && tablebase->probe(game, solved)) {
+            return solved.score();
+        }
+
+        // Terminal node (leaf or depth limit)
+        if (depth == 0 || game.isTerminal()) {
+            return game.evaluate();
+        }
+
+        std::vector<Move> &moves = moveStack[ply];
+        moves.clear();
+        game.generateMoves(moves);
+        if (moves.empty()) {
+            return game.evaluate();
+        }
+
+        int best = -SCORE_INF;
+        for (size_t i = 0; i < moves.size(); i++) {
+            Move move = moves[i];
+            game.makeMove(move);
+            int value = -alphaBeta(depth - 1, ply + 1, -beta, -alpha);
+            game.unmakeMove(move);
+
+            if (value > best) {
+                best = value;
+                if (ply == 0) {
+                    bestMove = move;
+                }
+            }
+            alpha = std::max(alpha, best);
+
+            // Alpha-Beta pruning
+            if (alpha >= beta) {
+                break;
+            }
+        }
+        return best;
+    }
+
+    Move bestMove = Move();      // Best move at the root after search()
+    unsigned long long nodes = 0; // Nodes visited by the last search()
+
+private:
+    Game &game;
+    std::vector<std::vector<Move>> moveStack; // Move list per ply
+};
+
+#endif
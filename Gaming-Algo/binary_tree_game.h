@@ -0,0 +1,55 @@
+#ifndef BINARY_TREE_GAME_H
+#define BINARY_TREE_GAME_H
+
+#include <vector>
+#include <cstdint>
+
+// The game tree from alpha_beta_pruning.ipynb: a complete tree whose leaves are stored in a flat
+// values array, where child i of node n is node n * branching + i. The first player maximizes.
+class BinaryTreeGame {
+public:
+    typedef int Move;
+
+    BinaryTreeGame(const std::vector<int> &leafValues, int maxDepth, int branching = 2)
+        : values(leafValues), maxDepth(maxDepth), branching(branching), depth(0), nodeIndex(0) {}
+
+    void generateMoves(std::vector<Move> &moves) const {
+        for (int i = 0; i < branching; i++) {
+            moves.push_back(i);
+        }
+    }
+
+    void makeMove(Move move) {
+        nodeIndex = nodeIndex * branching + move;
+        depth++;
+    }
+
+    void unmakeMove(Move move) {
+        nodeIndex = (nodeIndex - move) / branching;
+        depth--;
+    }
+
+    bool isTerminal() const {
+        return depth == maxDepth;
+    }
+
+    // Leaf value, negated when the minimizing player is to move
+    int evaluate() const {
+        int value = depth == maxDepth ? values[nodeIndex] : 0;
+        return depth % 2 == 0 ? value : -value;
+    }
+
+    // Node position in the implicit tree; unique per node
+    uint64_t hash() const {
+        return (static_cast<uint64_t>(nodeIndex) << 8 | static_cast<uint64_t>(depth)) * 0x9e3779b97f4a7c15ULL;
+    }
+
+private:
+    std::vector<int> values;
+    int maxDepth;
+    int branching;
+    int depth;
+    long long nodeIndex;
+};
+
+#endif
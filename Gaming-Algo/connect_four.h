@@ -0,0 +1,124 @@
+#ifndef CONNECT_FOUR_H
+#define CONNECT_FOUR_H
+
+#include <vector>
+#include <string>
+#include <cstdint>
+
+// Connect Four on 64-bit boards, the reference workload for the game-search benchmarks.
+//
+// Each of the 7 columns takes 7 bits (6 cells plus an always-empty sentinel above them), so four
+// in a row in any direction is a shift by 1 (vertical), 7 (horizontal), 6 or 8 (diagonals).
+// `mask` holds every stone and `current` the stones of the side to move. Playing a column adds
+// the lowest empty cell of the column to the mask; unmaking removes the highest stone, so no undo
+// history is needed. Moves are column numbers 0..6, generated centre first.
+class ConnectFour {
+public:
+    typedef int Move;
+
+    static const int WIDTH = 7;
+    static const int HEIGHT = 6;
+    static const int WIN_SCORE = 1000;
+
+    ConnectFour() {}
+
+    // Position after a sequence of columns numbered from 1, e.g. "4453"
+    explicit ConnectFour(const std::string &moves) {
+        for (char c : moves) {
+            makeMove(c - '1');
+        }
+    }
+
+    void generateMoves(std::vector<Move> &moves) const {
+        static const int order[WIDTH] = {3, 2, 4, 1, 5, 0, 6};
+        for (int column : order) {
+            if (!(mask & topCell(column))) moves.push_back(column);
+        }
+    }
+
+    void makeMove(Move column) {
+        current ^= mask;
+        mask |= mask + bottomCell(column);
+        ply++;
+    }
+
+    void unmakeMove(Move column) {
+        uint64_t stones = mask & columnMask(column);
+        uint64_t highest = uint64_t(1) << (63 - __builtin_clzll(stones));
+        mask ^= highest;
+        current ^= mask;
+        ply--;
+    }
+
+    bool isTerminal() const {
+        return ply == WIDTH * HEIGHT || hasFour(current ^ mask);
+    }
+
+    // Lost if the opponent has just connected four (sooner is worse), otherwise the difference in
+    // cells that would complete a four, plus a small bonus for stones in the centre column
+    int evaluate() const {
+        uint64_t opponent = current ^ mask;
+        if (hasFour(opponent)) return ply - WIN_SCORE;
+        uint64_t empty = BOARD & ~mask;
+        int threats = __builtin_popcountll(winningCells(current) & empty) -
+                      __builtin_popcountll(winningCells(opponent) & empty);
+        int centre = __builtin_popcountll(current & columnMask(3)) - __builtin_popcountll(opponent & columnMask(3));
+        return 10 * threats + 3 * centre;
+    }
+
+    // current + mask is unique per position (see Pascal Pons' solver)
+    uint64_t hash() const {
+        uint64_t x = current + mask;
+        x = (x ^ (x >> 31)) * 0x9e3779b97f4a7c15ULL;
+        return x ^ (x >> 29);
+    }
+
+    int moveCount() const {
+        return ply;
+    }
+
+private:
+    static const uint64_t BOTTOM = 0x0040810204081ULL; // Lowest cell of every column
+    static const uint64_t BOARD = BOTTOM * ((uint64_t(1) << HEIGHT) - 1);
+
+    uint64_t current = 0; // Stones of the side to move
+    uint64_t mask = 0;    // All stones
+    int ply = 0;
+
+    static uint64_t bottomCell(int column) {
+        return uint64_t(1) << (column * (HEIGHT + 1));
+    }
+
+    static uint64_t topCell(int column) {
+        return uint64_t(1) << (column * (HEIGHT + 1) + HEIGHT - 1);
+    }
+
+    static uint64_t columnMask(int column) {
+        return ((uint64_t(1) << HEIGHT) - 1) << (column * (HEIGHT + 1));
+    }
+
+    static bool hasFour(uint64_t stones) {
+        for (int shift : {1, HEIGHT, HEIGHT + 1, HEIGHT + 2}) {
+            uint64_t pairs = stones & (stones >> shift);
+            if (pairs & (pairs >> (2 * shift))) return true;
+        }
+        return false;
+    }
+
+    // Cells (empty or not) that would complete a four for `stones`
+    static uint64_t winningCells(uint64_t stones) {
+        // Vertical: three stacked stones, cell above them
+        uint64_t result = (stones << 1) & (stones << 2) & (stones << 3);
+        for (int shift : {HEIGHT, HEIGHT + 1, HEIGHT + 2}) {
+            uint64_t pairs = (stones << shift) & (stones << 2 * shift);
+            result |= pairs & (stones << 3 * shift); // xxx.
+            result |= pairs & (stones >> shift);     // xx.x
+            pairs = (stones >> shift) & (stones >> 2 * shift);
+            result |= pairs & (stones >> 3 * shift); // .xxx
+            result |= pairs & (stones << shift);     // x.xx
+        }
+        return result & BOARD;
+    }
+};
+
+#endif
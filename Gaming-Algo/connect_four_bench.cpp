@@ -0,0 +1,89 @@
+#include <iostream>
+#include <vector>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include "connect_four.h"
+#include "alpha_beta.h"
+#include "transposition_table.h"
+#include "search_driver.h"
+
+// Number of positions exactly `depth` plies below the current one (games that end sooner do not count)
+template <typename Game>
+unsigned long long perft(Game &game, int depth, std::vector<std::vector<typename Game::Move>> &moveStack) {
+    if (depth == 0) return 1;
+    if (game.isTerminal()) return 0;
+    std::vector<typename Game::Move> &moves = moveStack[depth];
+    moves.clear();
+    game.generateMoves(moves);
+    if (depth == 1) return moves.size();
+    unsigned long long leaves = 0;
+    for (auto move : moves) {
+        game.makeMove(move);
+        leaves += perft(game, depth - 1, moveStack);
+        game.unmakeMove(move);
+    }
+    return leaves;
+}
+
+double secondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+// Usage: connect_four_bench [perft depth] [search depth]
+int main(int argc, char *argv[]) {
+    int perftDepth = argc > 1 ? std::atoi(argv[1]) : 9;
+    int searchDepth = argc > 2 ? std::atoi(argv[2]) : 14;
+
+    // Move generation and make/unmake throughput from the empty board
+    std::cout << "Perft from the empty board:\n";
+    ConnectFour empty;
+    std::vector<std::vector<ConnectFour::Move>> moveStack(perftDepth + 1);
+    for (int depth = 1; depth <= perftDepth; depth++) {
+        auto start = std::chrono::steady_clock::now();
+        unsigned long long leaves = perft(empty, depth, moveStack);
+        double seconds = secondsSince(start);
+        std::cout << "  depth " << depth << ": " << leaves << " leaves, " << seconds << " s ("
+                  << static_cast<long long>(leaves / std::max(seconds, 1e-9)) << " leaves/s)\n";
+    }
+
+    // Search throughput on a fixed opening position
+    const std::string position = "4453";
+    std::cout << "Fixed position " << position << ":\n";
+
+    ConnectFour plainGame(position);
+    AlphaBetaSearch<ConnectFour> plain(plainGame);
+    auto start = std::chrono::steady_clock::now();
+    int plainScore = plain.search(searchDepth - 4);
+    double plainSeconds = secondsSince(start);
+    std::cout << "  alpha-beta depth " << searchDepth - 4 << ": score " << plainScore << ", " << plain.nodes
+              << " nodes, " << static_cast<long long>(plain.nodes / std::max(plainSeconds, 1e-9)) << " nodes/s\n";
+
+    // Effective branching factor: nodes of one iteration over nodes of the one before
+    ConnectFour game(position);
+    TranspositionTable table(64);
+    IterativeDeepeningSearch<ConnectFour> search(game);
+    search.table = &table;
+    SearchLimits limits;
+    limits.maxDepth = searchDepth;
+    auto result = search.think(limits);
+    unsigned long long previousNodes = 0;
+    unsigned long long previousIteration = 0;
+    for (const auto &iteration : search.iterations) {
+        unsigned long long iterationNodes = iteration.nodes - previousNodes;
+        std::cout << "  iterative deepening depth " << iteration.depth << ": score " << iteration.score
+                  << ", " << iterationNodes << " nodes";
+        if (previousIteration) {
+            std::cout << ", branching factor " << static_cast<double>(iterationNodes) / previousIteration;
+        }
+        std::cout << "\n";
+        previousNodes = iteration.nodes;
+        previousIteration = iterationNodes;
+    }
+    std::cout << "  best move " << result.bestMove + 1 << ", " << result.nodes << " nodes in " << result.seconds
+              << " s (" << static_cast<long long>(result.nodes / std::max(result.seconds, 1e-9))
+              << " nodes/s), effective branching factor "
+              << std::pow(static_cast<double>(result.nodes), 1.0 / std::max(result.depth, 1)) << std::endl;
+
+    return 0;
+}
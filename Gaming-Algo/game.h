@@ -0,0 +1,24 @@
+#ifndef GAME_H
+#define GAME_H
+
+#include <limits>
+
+// Scores are from the point of view of the side to move (negamax convention).
+const int SCORE_INF = std::numeric_limits<int>::max() / 2;
+
+// The Game concept used by the game-search engines.
+//
+// A Game type holds the current position and must provide:
+//
+//   typedef int Move;                                 // A move; small non-negative integer
+//   void generateMoves(std::vector<Move> &moves) const; // Append the legal moves
+//   void makeMove(Move move);                         // Play a move
+//   void unmakeMove(Move move);                       // Take back the last move played
+//   bool isTerminal() const;                          // No further play (game over or leaf)
+//   int evaluate() const;                             // Static score for the side to move
+//   uint64_t hash() const;                            // Position key for transposition tables
+//
+// Moves are plain integers so engines can index ordering tables by them.
+// Games small enough for a tablebase also provide perfect indexing (see tablebase.h).
+
+#endif
@@ -0,0 +1,67 @@
+#include <iostream>
+#include <vector>
+#include <thread>
+#include <chrono>
+#include <string>
+#include <cstdlib>
+#include "implicit_tree.h"
+
+// Leaf count of a complete tree, or 0 if it does not fit in 64 bits
+uint64_t leafCount(int branching, int depth) {
+    uint64_t count = 1;
+    for (int d = 0; d < depth; d++) {
+        if (count > UINT64_MAX / branching) return 0;
+        count *= branching;
+    }
+    return count;
+}
+
+// Largest stored tree: 2^28 leaves of 4 bytes, 1 GB
+const uint64_t MAX_STORED_LEAVES = 1ull << 28;
+
+template <typename Leaves>
+void benchmark(const std::string &label, const Leaves &leaves, int branching, int depth) {
+    ImplicitTreeSolver<Leaves> solver(leaves, branching, depth);
+    auto start = std::chrono::steady_clock::now();
+    int value = solver.solve();
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << label << ", branching " << branching << ", depth " << depth << " ("
+              << leafCount(branching, depth) << " leaves): value " << value << ", "
+              << solver.nodes << " interior nodes, " << solver.leavesEvaluated << " leaves read in "
+              << seconds << " s (" << static_cast<long long>(solver.leavesEvaluated / std::max(seconds, 1e-9))
+              << " leaves/s)" << std::endl;
+}
+
+// Usage: implicit_tree [branching] [stored depth] [hashed depth]
+int main(int argc, char *argv[]) {
+    // The tree from alpha_beta_pruning.ipynb
+    ArrayLeaves notebook({3, 5, 2, 9, 12, 5, 23, 15});
+    ImplicitTreeSolver<ArrayLeaves> solver(notebook, 2, 3);
+    std::cout << "Optimal value: " << solver.solve() << std::endl;
+
+    int branching = argc > 1 ? std::atoi(argv[1]) : 16;
+    int storedDepth = argc > 2 ? std::atoi(argv[2]) : 6;
+    int hashedDepth = argc > 3 ? std::atoi(argv[3]) : 8;
+    if (branching < 2 || storedDepth < 1 || hashedDepth < 1 || !leafCount(branching, hashedDepth)) {
+        std::cerr << "Tree too large or invalid parameters" << std::endl;
+        return 1;
+    }
+    uint64_t storedLeaves = leafCount(branching, storedDepth);
+    if (!storedLeaves || storedLeaves > MAX_STORED_LEAVES) {
+        std::cerr << "Stored tree too large: at most " << MAX_STORED_LEAVES << " leaves" << std::endl;
+        return 1;
+    }
+
+    // Leaves stored in memory (4 bytes each), generated in parallel
+    int threads = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+    ArrayLeaves stored = ArrayLeaves::generate(storedLeaves, 42, threads);
+    benchmark("Stored leaves", stored, branching, storedDepth);
+
+    // Leaves computed from their index: no memory, so the tree can have billions of leaves
+    HashedLeaves hashed(42);
+    benchmark("Hashed leaves", hashed, branching, storedDepth);
+    benchmark("Hashed leaves", hashed, branching, hashedDepth);
+
+    return 0;
+}
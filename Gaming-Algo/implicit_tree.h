@@ -0,0 +1,214 @@
+#ifndef IMPLICIT_TREE_H
+#define IMPLICIT_TREE_H
+
+#include <vector>
+#include <thread>
+#include <algorithm>
+#include <limits>
+#include <cstdint>
+#include <cstddef>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE4_1__)
+#include <smmintrin.h>
+#endif
+
+// Deterministic pseudo-random leaf value in [0, 1000) for leaf `index` (SplitMix64 finalizer)
+inline int hashedLeafValue(uint64_t seed, uint64_t index) {
+    uint64_t x = seed + index * 0x9e3779b97f4a7c15ULL;
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+    x ^= x >> 31;
+    return static_cast<int>(x % 1000);
+}
+
+// Leaves stored in one contiguous array, as in the notebook's `values` list.
+// Blocks of sibling leaves are reduced with SIMD min/max where the CPU supports it.
+class ArrayLeaves {
+public:
+    std::vector<int32_t> values;
+
+    ArrayLeaves() {}
+    explicit ArrayLeaves(const std::vector<int32_t> &values) : values(values) {}
+
+    // Fill `count` leaves with hashedLeafValue, split across threads
+    static ArrayLeaves generate(uint64_t count, uint64_t seed, int numThreads) {
+        ArrayLeaves leaves;
+        leaves.values.resize(count);
+        numThreads = std::max(1, numThreads);
+        std::vector<std::thread> workers;
+        uint64_t chunk = (count + numThreads - 1) / numThreads;
+        for (int t = 0; t < numThreads; t++) {
+            workers.emplace_back([&leaves, t, chunk, count, seed]() {
+                uint64_t end = std::min(count, (t + 1) * chunk);
+                for (uint64_t i = t * chunk; i < end; i++) {
+                    leaves.values[i] = hashedLeafValue(seed, i);
+                }
+            });
+        }
+        for (auto &worker : workers) {
+            worker.join();
+        }
+        return leaves;
+    }
+
+    int blockMax(uint64_t first, int count) const {
+        const int32_t *p = values.data() + first;
+        int i = 0;
+        int result = std::numeric_limits<int>::min();
+#if defined(__AVX2__)
+        if (count >= 8) {
+            __m256i best = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+            for (i = 8; i + 8 <= count; i += 8) {
+                best = _mm256_max_epi32(best, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + i)));
+            }
+            __m128i half = _mm_max_epi32(_mm256_castsi256_si128(best), _mm256_extracti128_si256(best, 1));
+            result = horizontalMax(half);
+        }
+#elif defined(__SSE4_1__)
+        if (count >= 4) {
+            __m128i best = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+            for (i = 4; i + 4 <= count; i += 4) {
+                best = _mm_max_epi32(best, _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i)));
+            }
+            result = horizontalMax(best);
+        }
+#endif
+        for (; i < count; i++) {
+            result = std::max(result, p[i]);
+        }
+        return result;
+    }
+
+    int blockMin(uint64_t first, int count) const {
+        const int32_t *p = values.data() + first;
+        int i = 0;
+        int result = std::numeric_limits<int>::max();
+#if defined(__AVX2__)
+        if (count >= 8) {
+            __m256i best = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+            for (i = 8; i + 8 <= count; i += 8) {
+                best = _mm256_min_epi32(best, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + i)));
+            }
+            __m128i half = _mm_min_epi32(_mm256_castsi256_si128(best), _mm256_extracti128_si256(best, 1));
+            result = horizontalMin(half);
+        }
+#elif defined(__SSE4_1__)
+        if (count >= 4) {
+            __m128i best = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+            for (i = 4; i + 4 <= count; i += 4) {
+                best = _mm_min_epi32(best, _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i)));
+            }
+            result = horizontalMin(best);
+        }
+#endif
+        for (; i < count; i++) {
+            result = std::min(result, p[i]);
+        }
+        return result;
+    }
+
+private:
+#if defined(__AVX2__) || defined(__SSE4_1__)
+    static int horizontalMax(__m128i v) {
+        v = _mm_max_epi32(v, _mm_shuffle_epi32(v, _MM_SHUFFLE(1, 0, 3, 2)));
+        v = _mm_max_epi32(v, _mm_shuffle_epi32(v, _MM_SHUFFLE(2, 3, 0, 1)));
+        return _mm_cvtsi128_si32(v);
+    }
+
+    static int horizontalMin(__m128i v) {
+        v = _mm_min_epi32(v, _mm_shuffle_epi32(v, _MM_SHUFFLE(1, 0, 3, 2)));
+        v = _mm_min_epi32(v, _mm_shuffle_epi32(v, _MM_SHUFFLE(2, 3, 0, 1)));
+        return _mm_cvtsi128_si32(v);
+    }
+#endif
+};
+
+// Leaves computed on demand from their index, for trees with billions of leaves that would not
+// fit in memory. The loops are simple enough for the compiler to vectorize.
+class HashedLeaves {
+public:
+    explicit HashedLeaves(uint64_t seed) : seed(seed) {}
+
+    int blockMax(uint64_t first, int count) const {
+        int result = std::numeric_limits<int>::min();
+        for (int i = 0; i < count; i++) {
+            result = std::max(result, hashedLeafValue(seed, first + i));
+        }
+        return result;
+    }
+
+    int blockMin(uint64_t first, int count) const {
+        int result = std::numeric_limits<int>::max();
+        for (int i = 0; i < count; i++) {
+            result = std::min(result, hashedLeafValue(seed, first + i));
+        }
+        return result;
+    }
+
+private:
+    uint64_t seed;
+};
+
+// Alpha-beta over an implicit complete tree with the given branching factor and depth.
+// Child i of node n (at any level) is node n * branching + i, so the leaves under the last
+// interior level are one contiguous block. That level is evaluated with a single min/max block
+// reduction; alpha-beta cutoffs apply at every level above it. The first player (root) maximizes,
+// and leaf values are from the maximizer's point of view.
+template <typename Leaves>
+class ImplicitTreeSolver {
+public:
+    ImplicitTreeSolver(const Leaves &leaves, int branching, int depth)
+        : leaves(leaves), branching(branching), depth(depth) {}
+
+    int solve() {
+        nodes = 0;
+        leavesEvaluated = 0;
+        if (depth == 0) {
+            leavesEvaluated = 1;
+            return leaves.blockMax(0, 1);
+        }
+        return alphaBeta(0, 0, std::numeric_limits<int>::min(), std::numeric_limits<int>::max());
+    }
+
+    unsigned long long nodes = 0;           // Interior nodes visited
+    unsigned long long leavesEvaluated = 0; // Leaves read by block reductions
+
+private:
+    const Leaves &leaves;
+    int branching;
+    int depth;
+
+    int alphaBeta(int level, uint64_t index, int alpha, int beta) {
+        nodes++;
+        bool maximizing = level % 2 == 0;
+
+        // Last interior level: its children are one contiguous block of leaves
+        if (level == depth - 1) {
+            uint64_t first = index * branching;
+            leavesEvaluated += branching;
+            return maximizing ? leaves.blockMax(first, branching) : leaves.blockMin(first, branching);
+        }
+
+        if (maximizing) {
+            int best = std::numeric_limits<int>::min();
+            for (int i = 0; i < branching; i++) {
+                best = std::max(best, alphaBeta(level + 1, index * branching + i, alpha, beta));
+                alpha = std::max(alpha, best);
+                if (alpha >= beta) break; // Alpha-Beta pruning
+            }
+            return best;
+        }
+
+        int best = std::numeric_limits<int>::max();
+        for (int i = 0; i < branching; i++) {
+            best = std::min(best, alphaBeta(level + 1, index * branching + i, alpha, beta));
+            beta = std::min(beta, best);
+            if (alpha >= beta) break; // Alpha-Beta pruning
+        }
+        return best;
+    }
+};
+
+#endif
@@ -0,0 +1,43 @@
+#include <iostream>
+#include <vector>
+#include "random_tree_game.h"
+#include "alpha_beta.h"
+#include "search_driver.h"
+
+int main() {
+    int branching = 8;
+    int fixedDepth = 7;
+
+    // Plain alpha-beta in generation order, to the fixed depth
+    RandomTreeGame plainGame(branching, 64);
+    AlphaBetaSearch<RandomTreeGame> plain(plainGame);
+    int plainScore = plain.search(fixedDepth);
+    std::cout << "Plain alpha-beta, depth " << fixedDepth << ": score " << plainScore
+              << ", nodes " << plain.nodes << std::endl;
+
+    // Iterative deepening with PV / killer / history ordering, PVS and aspiration windows
+    RandomTreeGame game(branching, 64);
+    IterativeDeepeningSearch<RandomTreeGame> search(game);
+    SearchLimits limits;
+    limits.maxDepth = fixedDepth;
+    auto result = search.think(limits);
+    std::cout << "Iterative deepening, depth " << result.depth << ": score " << result.score
+              << ", nodes " << result.nodes << " (all iterations)" << std::endl;
+
+    // Search under a one second budget and report every completed iteration
+    limits.maxDepth = 64;
+    limits.timeLimitSeconds = 1.0;
+    result = search.think(limits);
+    for (const auto &iteration : search.iterations) {
+        std::cout << "depth " << iteration.depth << "  score " << iteration.score
+                  << "  nodes " << iteration.nodes << "  time " << iteration.seconds << " s  pv";
+        for (auto move : iteration.pv) {
+            std::cout << " " << move;
+        }
+        std::cout << std::endl;
+    }
+    std::cout << "Best move: " << result.bestMove << " (depth " << result.depth << ", "
+              << static_cast<long long>(result.nodes / std::max(result.seconds, 1e-9)) << " nodes/s)" << std::endl;
+
+    return 0;
+}
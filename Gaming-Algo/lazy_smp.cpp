@@ -0,0 +1,60 @@
+#include <iostream>
+#include <vector>
+#include <thread>
+#include <chrono>
+#include "random_tree_game.h"
+#include "transposition_table.h"
+#include "search_driver.h"
+#include "lazy_smp.h"
+
+int main() {
+    int branching = 8;
+    int depth = 10;
+    int maxThreads = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+    RandomTreeGame root(branching, 64);
+
+    // Thread counts to compare: 1, 2, 4, ... up to the number of cores
+    std::vector<int> threadCounts;
+    for (int threads = 1; threads < maxThreads; threads *= 2) {
+        threadCounts.push_back(threads);
+    }
+    threadCounts.push_back(maxThreads);
+
+    std::cout << "Lazy SMP, time to depth " << depth << ":\n";
+    double baseTime = 0;
+    for (int threads : threadCounts) {
+        TranspositionTable table(64, true);
+        LazySmpSearch<RandomTreeGame> search(root, table);
+        SearchLimits limits;
+        limits.maxDepth = depth;
+
+        auto start = std::chrono::steady_clock::now();
+        auto result = search.think(limits, threads);
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        if (threads == 1) baseTime = seconds;
+
+        std::cout << "  " << threads << " threads: score " << result.score << ", best move " << result.bestMove
+                  << ", " << seconds << " s, "
+                  << static_cast<long long>(search.totalNodes / std::max(seconds, 1e-9)) << " nodes/s, speedup "
+                  << baseTime / std::max(seconds, 1e-9) << "x, table hit rate "
+                  << table.hitRate() * 100 << "%, " << table.usagePermille() / 10.0 << "% full\n";
+    }
+
+    std::cout << "Young Brothers Wait, time to depth " << depth << ":\n";
+    for (int threads : threadCounts) {
+        TranspositionTable table(64, true);
+        YoungBrothersWaitSearch<RandomTreeGame> search(root, &table);
+
+        auto start = std::chrono::steady_clock::now();
+        int score = search.search(depth, threads);
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        if (threads == 1) baseTime = seconds;
+
+        std::cout << "  " << threads << " threads: score " << score << ", best move " << search.bestMove
+                  << ", " << seconds << " s, "
+                  << static_cast<long long>(search.nodes.load() / std::max(seconds, 1e-9)) << " nodes/s, speedup "
+                  << baseTime / std::max(seconds, 1e-9) << "x\n";
+    }
+
+    return 0;
+}
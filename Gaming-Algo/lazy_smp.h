@@ -0,0 +1,239 @@
+#ifndef LAZY_SMP_H
+#define LAZY_SMP_H
+
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <algorithm>
+#include "game.h"
+#include "transposition_table.h"
+#include "search_driver.h"
+
+// Lazy SMP: every thread runs its own iterative-deepening search of the same root position, each
+// on its own copy of the game. Threads share nothing but the lock-free transposition table, which
+// is what makes them help each other. Helper threads are staggered (odd helpers start one ply
+// deeper) so they fill the table ahead of the main thread. The main thread's result is returned.
+template <typename Game>
+class LazySmpSearch {
+public:
+    typedef typename Game::Move Move;
+
+    LazySmpSearch(const Game &root, TranspositionTable &table) : root(root), table(table) {}
+
+    SearchResult<Move> think(const SearchLimits &limits, int numThreads) {
+        std::atomic<bool> stop{false};
+        numThreads = std::max(1, numThreads);
+        table.newSearch();
+        std::vector<unsigned long long> helperNodes(numThreads, 0);
+
+        // Helpers search until the main thread finishes
+        std::vector<std::thread> helpers;
+        for (int t = 1; t < numThreads; t++) {
+            helpers.emplace_back([this, t, &limits, &stop, &helperNodes]() {
+                Game game = root;
+                IterativeDeepeningSearch<Game> search(game);
+                search.table = &table;
+                search.stopSignal = &stop;
+                SearchLimits helperLimits;
+                helperLimits.startDepth = 1 + t % 2;
+                helperLimits.maxDepth = limits.maxDepth + 1;
+                helperNodes[t] = search.think(helperLimits).nodes;
+            });
+        }
+
+        Game game = root;
+        IterativeDeepeningSearch<Game> search(game);
+        search.table = &table;
+        SearchResult<Move> result = search.think(limits);
+        iterations = search.iterations;
+
+        stop.store(true);
+        for (auto &helper : helpers) {
+            helper.join();
+        }
+
+        totalNodes = result.nodes;
+        for (unsigned long long count : helperNodes) {
+            totalNodes += count;
+        }
+        return result;
+    }
+
+    unsigned long long totalNodes = 0;                  // Nodes searched by all threads
+    std::vector<SearchResult<Move>> iterations;         // Main thread's completed iterations
+
+private:
+    const Game &root;
+    TranspositionTable &table;
+};
+
+// Young Brothers Wait (YBW) parallel alpha-beta, for comparison with Lazy SMP.
+// At a node deep enough to be worth splitting, the first (eldest) move is searched alone; only
+// once it has raised alpha are the younger brothers searched in parallel by idle threads, each on
+// its own copy of the game. A cutoff by any brother aborts the others.
+template <typename Game>
+class YoungBrothersWaitSearch {
+public:
+    typedef typename Game::Move Move;
+
+    int minSplitDepth = 3; // Nodes with less remaining depth are searched serially
+
+    explicit YoungBrothersWaitSearch(const Game &root, TranspositionTable *table = nullptr)
+        : root(root), table(table) {}
+
+    int search(int depth, int numThreads) {
+        nodes.store(0);
+        spareThreads.store(std::max(0, numThreads - 1));
+        Game game = root;
+        return alphaBeta(game, depth, 0, -SCORE_INF, SCORE_INF, nullptr);
+    }
+
+    Move bestMove = Move();
+    std::atomic<unsigned long long> nodes{0};
+
+private:
+    // Shared state of a node whose younger brothers are searched in parallel
+    struct SplitPoint {
+        const SplitPoint *parent;
+        std::atomic<int> alpha;
+        int beta;
+        std::atomic<bool> cutoff{false};
+        std::atomic<size_t> nextMove;
+        std::mutex lock;
+        int best;
+        Move bestMove;
+    };
+
+    const Game &root;
+    TranspositionTable *table;
+    std::atomic<int> spareThreads{0};
+
+    // True if any split point above this node has been cut off
+    static bool aborted(const SplitPoint *split) {
+        for (; split; split = split->parent) {
+            if (split->cutoff.load(std::memory_order_relaxed)) return true;
+        }
+        return false;
+    }
+
+    int alphaBeta(Game &game, int depth, int ply, int alpha, int beta, const SplitPoint *parentSplit) {
+        nodes.fetch_add(1, std::memory_order_relaxed);
+        if (depth == 0 || game.isTerminal()) {
+            return game.evaluate();
+        }
+
+        int originalAlpha = alpha;
+        int tableMove = -1;
+        TTData entry;
+        if (table && table->probe(game.hash(), entry)) {
+            tableMove = entry.move;
+            if (ply > 0 && entry.depth >= depth &&
+                (entry.bound == BOUND_EXACT ||
+                 (entry.bound == BOUND_LOWER && entry.score >= beta) ||
+                 (entry.bound == BOUND_UPPER && entry.score <= alpha))) {
+                return entry.score;
+            }
+        }
+
+        std::vector<Move> moves;
+        game.generateMoves(moves);
+        if (moves.empty()) {
+            return game.evaluate();
+        }
+        auto tableIt = std::find(moves.begin(), moves.end(), static_cast<Move>(tableMove));
+        if (tableIt != moves.end()) {
+            std::iter_swap(moves.begin(), tableIt);
+        }
+
+        // Eldest brother first, always serially
+        int best = -SCORE_INF;
+        Move bestLocal = moves[0];
+        size_t first = 0;
+        for (; first < moves.size(); first++) {
+            if (aborted(parentSplit)) return 0;
+            game.makeMove(moves[first]);
+            int value = -alphaBeta(game, depth - 1, ply + 1, -beta, -alpha, parentSplit);
+            game.unmakeMove(moves[first]);
+            if (value > best) {
+                best = value;
+                bestLocal = moves[first];
+            }
+            alpha = std::max(alpha, best);
+            if (alpha >= beta) break;
+            // Only the first move is forced serial; split once it is done if threads are idle
+            if (depth >= minSplitDepth && first + 1 < moves.size() && spareThreads.load(std::memory_order_relaxed) > 0) {
+                first++;
+                break;
+            }
+        }
+
+        if (alpha < beta && first < moves.size() && !aborted(parentSplit)) {
+            // Younger brothers: shared among this thread and any idle helpers
+            SplitPoint split;
+            split.parent = parentSplit;
+            split.alpha.store(alpha);
+            split.beta = beta;
+            split.nextMove.store(first);
+            split.best = best;
+            split.bestMove = bestLocal;
+
+            auto work = [this, &split, &moves, depth, ply](Game &position) {
+                while (true) {
+                    size_t i = split.nextMove.fetch_add(1);
+                    if (i >= moves.size() || aborted(&split)) break;
+                    int currentAlpha = split.alpha.load();
+                    position.makeMove(moves[i]);
+                    int value = -alphaBeta(position, depth - 1, ply + 1, -split.beta, -currentAlpha, &split);
+                    position.unmakeMove(moves[i]);
+                    if (aborted(&split)) break;
+
+                    std::lock_guard<std::mutex> guard(split.lock);
+                    if (value > split.best) {
+                        split.best = value;
+                        split.bestMove = moves[i];
+                    }
+                    if (value > split.alpha.load()) split.alpha.store(value);
+                    if (value >= split.beta) split.cutoff.store(true);
+                }
+            };
+
+            // Claim idle threads and give each a copy of the position before anyone moves on it
+            size_t helperCount = 0;
+            while (helperCount + 1 < moves.size() - first) {
+                if (spareThreads.fetch_sub(1) <= 0) {
+                    spareThreads.fetch_add(1);
+                    break;
+                }
+                helperCount++;
+            }
+            std::vector<Game> positions(helperCount, game);
+            std::vector<std::thread> helpers;
+            for (size_t h = 0; h < helperCount; h++) {
+                helpers.emplace_back([this, &work, &positions, h]() {
+                    work(positions[h]);
+                    spareThreads.fetch_add(1);
+                });
+            }
+            work(game);
+            for (auto &helper : helpers) {
+                helper.join();
+            }
+
+            if (aborted(parentSplit)) return 0;
+            best = split.best;
+            bestLocal = split.bestMove;
+        }
+
+        if (ply == 0) {
+            bestMove = bestLocal;
+        }
+        if (table && !aborted(parentSplit)) {
+            TTBound bound = best <= originalAlpha ? BOUND_UPPER : best >= beta ? BOUND_LOWER : BOUND_EXACT;
+            table->store(game.hash(), bound == BOUND_UPPER ? -1 : static_cast<int>(bestLocal), best, depth, bound);
+        }
+        return best;
+    }
+};
+
+#endif
@@ -0,0 +1,49 @@
+#include <iostream>
+#include <vector>
+#include <thread>
+#include "random_tree_game.h"
+#include "mcts.h"
+
+int main() {
+    int branching = 40; // Too wide for alpha-beta to search deeply
+    int maxThreads = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+    RandomTreeGame root(branching, 60);
+
+    // Thread counts to compare: 1, 2, 4, ... up to the number of cores
+    std::vector<int> threadCounts;
+    for (int threads = 1; threads < maxThreads; threads *= 2) {
+        threadCounts.push_back(threads);
+    }
+    threadCounts.push_back(maxThreads);
+
+    MctsLimits limits;
+    limits.timeLimitSeconds = 1.0;
+
+    std::cout << "MCTS with random playouts, " << limits.timeLimitSeconds << " s per search:\n";
+    double basePlayouts = 0;
+    for (int threads : threadCounts) {
+        MonteCarloTreeSearch<RandomTreeGame> search(root);
+        auto result = search.think(limits, threads);
+        double perSecond = result.playouts / std::max(result.seconds, 1e-9);
+        if (threads == 1) basePlayouts = perSecond;
+
+        std::cout << "  " << threads << " threads: best move " << result.bestMove << " (" << result.visits
+                  << " visits, win rate " << result.winRate << "), " << static_cast<long long>(perSecond)
+                  << " playouts/s, speedup " << perSecond / std::max(basePlayouts, 1e-9) << "x, "
+                  << result.treeNodes << " tree nodes\n";
+    }
+
+    // Evaluation instead of rollouts, then play a few moves keeping the tree between them
+    std::cout << "MCTS with evaluation playouts and tree reuse, " << maxThreads << " threads:\n";
+    MonteCarloTreeSearch<RandomTreeGame, EvaluationPlayout> game(root);
+    limits.timeLimitSeconds = 0.5;
+    for (int ply = 0; ply < 4; ply++) {
+        auto result = game.think(limits, maxThreads);
+        std::cout << "  ply " << ply << ": best move " << result.bestMove << ", win rate " << result.winRate
+                  << ", " << result.playouts << " playouts";
+        bool reused = game.advance(result.bestMove);
+        std::cout << ", " << (reused ? "kept " : "discarded tree, ") << game.treeSize() << " nodes\n";
+    }
+
+    return 0;
+}
@@ -0,0 +1,340 @@
+#ifndef MCTS_H
+#define MCTS_H
+
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <memory>
+#include <chrono>
+#include <random>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include "game.h"
+
+// Playout policies turn a position into a reward in [0, 1] for the side to move. They may play
+// moves on the game but must take them all back before returning.
+
+// Random moves until the game ends (or maxPlies), then the final evaluation squashed by a logistic
+// curve: win/loss scores saturate to 1/0, smaller scores give partial credit.
+struct RandomPlayout {
+    int maxPlies = 1000;
+    double scale = 100;
+
+    template <typename Game>
+    double operator()(Game &game, std::mt19937_64 &rng) {
+        std::vector<typename Game::Move> played;
+        std::vector<typename Game::Move> moves;
+        while (!game.isTerminal() && static_cast<int>(played.size()) < maxPlies) {
+            moves.clear();
+            game.generateMoves(moves);
+            if (moves.empty()) break;
+            typename Game::Move move = moves[rng() % moves.size()];
+            game.makeMove(move);
+            played.push_back(move);
+        }
+        double score = game.evaluate();
+        for (size_t i = played.size(); i-- > 0;) {
+            game.unmakeMove(played[i]);
+        }
+        // The evaluation is for the side to move at the end; flip it back if that is the opponent
+        if (played.size() % 2 == 1) score = -score;
+        return 1.0 / (1.0 + std::exp(-score / scale));
+    }
+};
+
+// No rollout: the static evaluation of the position itself, squashed like RandomPlayout's
+struct EvaluationPlayout {
+    double scale = 100;
+
+    template <typename Game>
+    double operator()(Game &game, std::mt19937_64 &) {
+        return 1.0 / (1.0 + std::exp(-game.evaluate() / scale));
+    }
+};
+
+// Limits for one MCTS search; zero means "no limit"
+struct MctsLimits {
+    unsigned long long playouts = 0;
+    double timeLimitSeconds = 0;
+};
+
+template <typename Move>
+struct MctsResult {
+    Move bestMove = Move();        // Most visited root move
+    unsigned int visits = 0;       // Visits of the best move
+    double winRate = 0;            // Mean reward of the best move for the side to move
+    unsigned long long playouts = 0;
+    double seconds = 0;
+    size_t treeNodes = 0;          // Nodes in the tree when the search stopped
+};
+
+// Tree-parallel Monte Carlo Tree Search with UCT selection for any Game (see game.h).
+//
+// All threads descend one shared tree. Nodes live in a preallocated pool and the children of a
+// node are one contiguous block, claimed with a single atomic bump of the pool's end. Visit counts
+// and reward sums are atomics. On the way down each thread adds a virtual loss to every node it
+// passes (extra visits with no reward), which steers the other threads to different paths until
+// the real result is backed up. When the pool is full the tree stops growing and playouts start
+// from its leaves.
+//
+// After a move is played, advance() keeps the subtree below it: it is copied into a second pool
+// so the search of the next move starts with the statistics already gathered.
+template <typename Game, typename Playout = RandomPlayout>
+class MonteCarloTreeSearch {
+public:
+    typedef typename Game::Move Move;
+
+    double exploration = 1.4; // UCT exploration constant
+    int virtualLoss = 3;      // Visits added to a node while a thread is below it
+
+    explicit MonteCarloTreeSearch(const Game &root, size_t maxNodes = 1 << 20, Playout playout = Playout())
+        : rootGame(root), playout(playout), capacity(std::max<size_t>(maxNodes, 1)) {
+        pools[0].reset(new Node[capacity]);
+        pools[1].reset(new Node[capacity]);
+        resetTree();
+    }
+
+    MctsResult<Move> think(const MctsLimits &limits, int numThreads) {
+        numThreads = std::max(1, numThreads);
+        startTime = std::chrono::steady_clock::now();
+        playoutCount.store(0);
+        stop.store(false);
+
+        std::vector<std::thread> workers;
+        for (int t = 0; t < numThreads; t++) {
+            workers.emplace_back([this, t, &limits]() {
+                worker(limits, t);
+            });
+        }
+        for (auto &worker : workers) {
+            worker.join();
+        }
+
+        MctsResult<Move> result;
+        result.playouts = limits.playouts ? std::min(playoutCount.load(), limits.playouts) : playoutCount.load();
+        result.seconds = elapsed();
+        result.treeNodes = treeSize();
+        const Node &root = nodes()[0];
+        if (root.state.load() == EXPANDED) {
+            for (uint32_t i = 0; i < root.childCount; i++) {
+                const Node &child = nodes()[root.firstChild + i];
+                unsigned int visits = child.visits.load();
+                if (i == 0 || visits > result.visits) {
+                    result.bestMove = child.move;
+                    result.visits = visits;
+                    result.winRate = visits ? static_cast<double>(child.value.load()) / VALUE_SCALE / visits : 0;
+                }
+            }
+        }
+        return result;
+    }
+
+    // Play `move` at the root. The move's subtree becomes the new tree; returns false if the move
+    // had not been expanded yet and the tree starts over.
+    bool advance(Move move) {
+        rootGame.makeMove(move);
+        const Node &root = nodes()[0];
+        uint32_t kept = NONE;
+        if (root.state.load() == EXPANDED) {
+            for (uint32_t i = 0; i < root.childCount; i++) {
+                if (nodes()[root.firstChild + i].move == move) kept = root.firstChild + i;
+            }
+        }
+        if (kept == NONE) {
+            resetTree();
+            return false;
+        }
+
+        // Breadth-first copy keeps every block of siblings contiguous in the new pool
+        Node *from = nodes();
+        Node *to = pools[1 - active].get();
+        copyNode(from[kept], to[0]);
+        size_t end = 1;
+        std::vector<std::pair<uint32_t, uint32_t>> queue = {{kept, 0}};
+        for (size_t q = 0; q < queue.size(); q++) {
+            const Node &source = from[queue[q].first];
+            Node &target = to[queue[q].second];
+            if (source.state.load() != EXPANDED) {
+                target.state.store(UNEXPANDED);
+                continue;
+            }
+            target.firstChild = static_cast<uint32_t>(end);
+            target.childCount = source.childCount;
+            target.state.store(EXPANDED);
+            for (uint32_t i = 0; i < source.childCount; i++) {
+                copyNode(from[source.firstChild + i], to[end]);
+                queue.push_back({source.firstChild + i, static_cast<uint32_t>(end)});
+                end++;
+            }
+        }
+        active = 1 - active;
+        used.store(end);
+        return true;
+    }
+
+    // Nodes in use in the pool
+    size_t treeSize() const {
+        return std::min(used.load(), capacity);
+    }
+
+    const Game &position() const {
+        return rootGame;
+    }
+
+private:
+    static const uint8_t UNEXPANDED = 0;
+    static const uint8_t EXPANDING = 1;
+    static const uint8_t EXPANDED = 2;
+    static const uint32_t NONE = UINT32_MAX;
+    static constexpr double VALUE_SCALE = 1 << 16; // Rewards are summed in 16.16 fixed point
+
+    struct Node {
+        std::atomic<uint32_t> visits{0};
+        std::atomic<int64_t> value{0}; // Reward sum for the player who moved into this node
+        std::atomic<uint8_t> state{UNEXPANDED};
+        uint32_t firstChild = 0;       // Written before state becomes EXPANDED
+        uint32_t childCount = 0;
+        Move move = Move();
+    };
+
+    Game rootGame;
+    Playout playout;
+    size_t capacity;
+    std::unique_ptr<Node[]> pools[2];
+    int active = 0;
+    std::atomic<size_t> used{0};
+    std::atomic<unsigned long long> playoutCount{0};
+    std::atomic<bool> stop{false};
+    std::chrono::steady_clock::time_point startTime;
+
+    Node *nodes() const {
+        return pools[active].get();
+    }
+
+    double elapsed() const {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+    }
+
+    void resetTree() {
+        active = 0;
+        copyNode(Node(), nodes()[0]);
+        used.store(1);
+    }
+
+    static void copyNode(const Node &from, Node &to) {
+        to.visits.store(from.visits.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        to.value.store(from.value.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        to.state.store(UNEXPANDED, std::memory_order_relaxed);
+        to.firstChild = 0;
+        to.childCount = 0;
+        to.move = from.move;
+    }
+
+    // Claim `count` consecutive nodes; NONE if the pool is full
+    uint32_t allocate(size_t count) {
+        size_t first = used.fetch_add(count, std::memory_order_relaxed);
+        return first + count <= capacity ? static_cast<uint32_t>(first) : NONE;
+    }
+
+    // Child with the highest UCT score; unvisited children first
+    uint32_t select(const Node &node) const {
+        double logParent = std::log(std::max<uint32_t>(node.visits.load(std::memory_order_relaxed), 1));
+        uint32_t best = node.firstChild;
+        double bestScore = -1;
+        for (uint32_t i = 0; i < node.childCount; i++) {
+            const Node &child = nodes()[node.firstChild + i];
+            uint32_t visits = child.visits.load(std::memory_order_relaxed);
+            if (visits == 0) return node.firstChild + i;
+            double mean = static_cast<double>(child.value.load(std::memory_order_relaxed)) / VALUE_SCALE / visits;
+            double score = mean + exploration * std::sqrt(logParent / visits);
+            if (score > bestScore) {
+                bestScore = score;
+                best = node.firstChild + i;
+            }
+        }
+        return best;
+    }
+
+    // Create the children of `node`, unless another thread is already doing it or the pool is full
+    bool expand(Node &node, Game &game, std::vector<Move> &moves) {
+        uint8_t expected = UNEXPANDED;
+        if (!node.state.compare_exchange_strong(expected, EXPANDING, std::memory_order_acquire)) {
+            return false;
+        }
+        moves.clear();
+        game.generateMoves(moves);
+        uint32_t first = moves.empty() ? 0 : allocate(moves.size());
+        if (first == NONE) {
+            node.state.store(UNEXPANDED, std::memory_order_release);
+            return false;
+        }
+        for (size_t i = 0; i < moves.size(); i++) {
+            Node &child = nodes()[first + i];
+            child.visits.store(0, std::memory_order_relaxed);
+            child.value.store(0, std::memory_order_relaxed);
+            child.state.store(UNEXPANDED, std::memory_order_relaxed);
+            child.childCount = 0;
+            child.move = moves[i];
+        }
+        node.firstChild = first;
+        node.childCount = static_cast<uint32_t>(moves.size());
+        node.state.store(EXPANDED, std::memory_order_release);
+        return true;
+    }
+
+    void worker(const MctsLimits &limits, int t) {
+        Game game = rootGame;
+        Playout policy = playout;
+        std::mt19937_64 rng(0x9e3779b97f4a7c15ULL * (t + 1));
+        std::vector<uint32_t> path;
+        std::vector<Move> moves;
+        unsigned long long iteration = 0;
+
+        while (!stop.load(std::memory_order_relaxed)) {
+            if (limits.playouts && playoutCount.fetch_add(1, std::memory_order_relaxed) >= limits.playouts) {
+                stop.store(true);
+                break;
+            }
+            if (limits.timeLimitSeconds > 0 && (iteration++ & 63) == 0 && elapsed() >= limits.timeLimitSeconds) {
+                stop.store(true);
+                break;
+            }
+
+            // Selection: follow UCT down to a node that is not expanded, adding virtual loss
+            path.clear();
+            uint32_t current = 0;
+            while (true) {
+                Node &node = nodes()[current];
+                path.push_back(current);
+                node.visits.fetch_add(virtualLoss, std::memory_order_relaxed);
+                if (game.isTerminal()) break;
+                if (node.state.load(std::memory_order_acquire) != EXPANDED) {
+                    // Expansion: the thread that expands the node continues into its first child
+                    if (!expand(node, game, moves) || node.childCount == 0) break;
+                    current = node.firstChild;
+                    game.makeMove(nodes()[current].move);
+                    path.push_back(current);
+                    nodes()[current].visits.fetch_add(virtualLoss, std::memory_order_relaxed);
+                    break;
+                }
+                if (node.childCount == 0) break;
+                current = select(node);
+                game.makeMove(nodes()[current].move);
+            }
+
+            // Playout, then back up: each node's reward is for the player who moved into it
+            double reward = 1.0 - policy(game, rng);
+            for (size_t i = path.size(); i-- > 0;) {
+                Node &node = nodes()[path[i]];
+                node.value.fetch_add(static_cast<int64_t>(reward * VALUE_SCALE), std::memory_order_relaxed);
+                node.visits.fetch_sub(virtualLoss - 1, std::memory_order_relaxed);
+                if (i > 0) game.unmakeMove(node.move);
+                reward = 1.0 - reward;
+            }
+            if (!limits.playouts) playoutCount.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+};
+
+#endif
@@ -0,0 +1,67 @@
+#ifndef RANDOM_TREE_GAME_H
+#define RANDOM_TREE_GAME_H
+
+#include <vector>
+#include <cstdint>
+
+// A synthetic game: a uniform tree of the given branching factor and depth whose positions are
+// identified by a hash of the move path. Each move changes the score by a pseudo-random amount,
+// so static evaluations are correlated with deeper results, as in real games. Moves are ordered
+// randomly, so good move ordering matters.
+class RandomTreeGame {
+public:
+    typedef int Move;
+
+    RandomTreeGame(int branching, int maxDepth, uint64_t seed = 1)
+        : branching(branching), maxDepth(maxDepth), key(mix(seed)), score(0) {}
+
+    void generateMoves(std::vector<Move> &moves) const {
+        for (int i = 0; i < branching; i++) {
+            moves.push_back(i);
+        }
+    }
+
+    void makeMove(Move move) {
+        history.push_back({key, score});
+        key = mix(key + static_cast<uint64_t>(move) + 1);
+        // Moving changes the first player's score by up to +/-50, signed by who moved
+        int delta = static_cast<int>(key % 101) - 50;
+        score += history.size() % 2 == 1 ? delta : -delta;
+    }
+
+    void unmakeMove(Move) {
+        key = history.back().first;
+        score = history.back().second;
+        history.pop_back();
+    }
+
+    bool isTerminal() const {
+        return static_cast<int>(history.size()) >= maxDepth;
+    }
+
+    int evaluate() const {
+        return history.size() % 2 == 0 ? score : -score;
+    }
+
+    // Position key, unique per move path
+    uint64_t hash() const {
+        return key;
+    }
+
+private:
+    int branching;
+    int maxDepth;
+    uint64_t key;
+    int score; // From the first player's point of view
+    std::vector<std::pair<uint64_t, int>> history;
+
+    // SplitMix64 finalizer
+    static uint64_t mix(uint64_t x) {
+        x += 0x9e3779b97f4a7c15ULL;
+        x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+        return x ^ (x >> 31);
+    }
+};
+
+#endif
@@ -0,0 +1,256 @@
+#ifndef SEARCH_DRIVER_H
+#define SEARCH_DRIVER_H
+
+#include <vector>
+#include <array>
+#include <algorithm>
+#include <chrono>
+#include <atomic>
+#include "game.h"
+#include "transposition_table.h"
+
+// Limits for one search; zero means "no limit" for the time and node budgets
+struct SearchLimits {
+    int startDepth = 1;
+    int maxDepth = 64;
+    double timeLimitSeconds = 0;
+    unsigned long long nodeLimit = 0;
+};
+
+// Result of the last completed iteration. depth == 0 means no iteration completed (the search
+// was stopped during depth 1): there is no move, and bestMove is NO_MOVE.
+template <typename Move>
+struct SearchResult {
+    static constexpr Move NO_MOVE = static_cast<Move>(-1);
+
+    Move bestMove = NO_MOVE;
+    int score = 0;
+    int depth = 0;
+    unsigned long long nodes = 0; // Nodes visited over all iterations so far
+    double seconds = 0;
+    std::vector<Move> pv;         // Principal variation
+};
+
+// Iterative deepening driver for any Game (see game.h).
+// Each iteration searches one ply deeper with principal-variation search (PVS) inside an
+// aspiration window around the previous score. Earlier iterations order the moves of later ones:
+// the previous principal variation first, then killer moves, then the history heuristic.
+// The search stops when the time or node budget runs out and keeps the last completed iteration.
+// Optionally a transposition table (shared with other searches) supplies the best move of earlier
+// searches and cuts off positions already searched deep enough; this needs Game::hash().
+template <typename Game>
+class IterativeDeepeningSearch {
+public:
+    typedef typename Game::Move Move;
+
+    // Half-width of the first aspiration window; it doubles after every fail
+    int aspirationWindow = 50;
+
+    TranspositionTable *table = nullptr;          // Optional, may be shared between threads
+    const std::atomic<bool> *stopSignal = nullptr; // Optional external request to stop
+
+    explicit IterativeDeepeningSearch(Game &game) : game(game) {}
+
+    SearchResult<Move> think(const SearchLimits &limits) {
+        this->limits = limits;
+        startTime = std::chrono::steady_clock::now();
+        nodes = 0;
+        stopped = false;
+        previousPV.clear();
+        iterations.clear();
+        std::fill(history.begin(), history.end(), 0);
+
+        SearchResult<Move> result;
+        size_t plies = static_cast<size_t>(limits.maxDepth) + 1;
+        moveStack.assign(plies, {});
+        pvTable.assign(plies, {});
+        killers.assign(plies, {NO_MOVE, NO_MOVE});
+
+        for (int depth = std::max(1, limits.startDepth); depth <= limits.maxDepth; depth++) {
+            int score;
+            if (result.depth == 0) {
+                score = pvs(depth, 0, -SCORE_INF, SCORE_INF, true);
+            } else {
+                // Aspiration window around the previous score, widened until the score falls inside
+                int window = aspirationWindow;
+                int alpha = result.score - window;
+                int beta = result.score + window;
+                while (true) {
+                    score = pvs(depth, 0, alpha, beta, true);
+                    if (stopped) break;
+                    if (score <= alpha) {
+                        alpha = window > SCORE_INF / 4 ? -SCORE_INF : result.score - window * 2;
+                    } else if (score >= beta) {
+                        beta = window > SCORE_INF / 4 ? SCORE_INF : result.score + window * 2;
+                    } else {
+                        break;
+                    }
+                    window *= 2;
+                }
+            }
+            if (stopped) break;
+
+            previousPV = pvTable[0];
+            result.score = score;
+            result.depth = depth;
+            result.pv = previousPV;
+            if (!previousPV.empty()) {
+                result.bestMove = previousPV[0];
+            }
+            result.nodes = nodes;
+            result.seconds = elapsed();
+            iterations.push_back(result);
+        }
+        result.nodes = nodes;
+        result.seconds = elapsed();
+        return result;
+    }
+
+    std::vector<SearchResult<Move>> iterations; // One entry per completed iteration
+
+private:
+    static constexpr Move NO_MOVE = SearchResult<Move>::NO_MOVE;
+
+    Game &game;
+    SearchLimits limits;
+    std::chrono::steady_clock::time_point startTime;
+    unsigned long long nodes = 0;
+    bool stopped = false;
+
+    std::vector<std::vector<Move>> moveStack;    // Move list per ply
+    std::vector<std::vector<Move>> pvTable;      // Triangular PV table: best line from each ply
+    std::vector<Move> previousPV;                // PV of the last completed iteration
+    std::vector<std::array<Move, 2>> killers;    // Two quiet cutoff moves per ply
+    std::vector<int> history;                    // Cutoff counts per move, weighted by depth
+
+    double elapsed() const {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+    }
+
+    // Check the budgets every 1024 nodes
+    void checkLimits() {
+        if ((nodes & 1023) != 0) return;
+        if (limits.nodeLimit && nodes >= limits.nodeLimit) stopped = true;
+        if (limits.timeLimitSeconds > 0 && elapsed() >= limits.timeLimitSeconds) stopped = true;
+        if (stopSignal && stopSignal->load(std::memory_order_relaxed)) stopped = true;
+    }
+
+    int historyScore(Move move) {
+        if (static_cast<size_t>(move) >= history.size()) {
+            history.resize(static_cast<size_t>(move) + 1, 0);
+        }
+        return history[move];
+    }
+
+    // Sort moves: previous PV move, then the table move, then killers, then history
+    void orderMoves(std::vector<Move> &moves, int ply, bool pvNode, Move tableMove) {
+        Move pvMove = pvNode && static_cast<size_t>(ply) < previousPV.size() ? previousPV[ply] : NO_MOVE;
+        std::vector<std::pair<int, Move>> scored;
+        scored.reserve(moves.size());
+        for (Move move : moves) {
+            int score = historyScore(move);
+            if (move == pvMove) {
+                score = SCORE_INF;
+            } else if (move == tableMove) {
+                score = SCORE_INF - 1;
+            } else if (move == killers[ply][0]) {
+                score = SCORE_INF - 2;
+            } else if (move == killers[ply][1]) {
+                score = SCORE_INF - 3;
+            }
+            scored.push_back({score, move});
+        }
+        std::stable_sort(scored.begin(), scored.end(), [](const std::pair<int, Move> &a, const std::pair<int, Move> &b) {
+            return a.first > b.first;
+        });
+        for (size_t i = 0; i < moves.size(); i++) {
+            moves[i] = scored[i].second;
+        }
+    }
+
+    // Principal-variation search (fail-soft negamax). pvNode is true while following the previous PV.
+    int pvs(int depth, int ply, int alpha, int beta, bool pvNode) {
+        nodes++;
+        checkLimits();
+        pvTable[ply].clear();
+        if (stopped) return 0;
+
+        if (depth == 0 || game.isTerminal()) {
+            return game.evaluate();
+        }
+
+        // Table lookup: reuse the stored best move, and the stored score off the PV
+        int originalAlpha = alpha;
+        Move tableMove = NO_MOVE;
+        TTData entry;
+        if (table && table->probe(game.hash(), entry)) {
+            tableMove = static_cast<Move>(entry.move);
+            if (ply > 0 && beta - alpha == 1 && entry.depth >= depth &&
+                (entry.bound == BOUND_EXACT ||
+                 (entry.bound == BOUND_LOWER && entry.score >= beta) ||
+                 (entry.bound == BOUND_UPPER && entry.score <= alpha))) {
+                return entry.score;
+            }
+        }
+
+        std::vector<Move> &moves = moveStack[ply];
+        moves.clear();
+        game.generateMoves(moves);
+        if (moves.empty()) {
+            return game.evaluate();
+        }
+        orderMoves(moves, ply, pvNode, tableMove);
+        Move pvMove = pvNode && static_cast<size_t>(ply) < previousPV.size() ? previousPV[ply] : NO_MOVE;
+
+        int best = -SCORE_INF;
+        Move bestMove = NO_MOVE;
+        for (size_t i = 0; i < moves.size(); i++) {
+            Move move = moves[i];
+            bool childPV = move == pvMove;
+            game.makeMove(move);
+            int value;
+            if (i == 0) {
+                value = -pvs(depth - 1, ply + 1, -beta, -alpha, childPV);
+            } else {
+                // Null-window probe: is this move better than the current best?
+                value = -pvs(depth - 1, ply + 1, -alpha - 1, -alpha, childPV);
+                if (value > alpha && value < beta && !stopped) {
+                    value = -pvs(depth - 1, ply + 1, -beta, -alpha, childPV);
+                }
+            }
+            game.unmakeMove(move);
+            if (stopped) return 0;
+
+            if (value > best) {
+                best = value;
+                bestMove = move;
+                if (value > alpha) {
+                    alpha = value;
+                    // Extend the principal variation with the child's line
+                    pvTable[ply].clear();
+                    pvTable[ply].push_back(move);
+                    pvTable[ply].insert(pvTable[ply].end(), pvTable[ply + 1].begin(), pvTable[ply + 1].end());
+                }
+            }
+
+            if (alpha >= beta) {
+                // Remember the cutoff move for sibling positions and for later iterations
+                if (move != killers[ply][0]) {
+                    killers[ply][1] = killers[ply][0];
+                    killers[ply][0] = move;
+                }
+                historyScore(move);
+                history[move] += depth * depth;
+                break;
+            }
+        }
+
+        if (table) {
+            TTBound bound = best <= originalAlpha ? BOUND_UPPER : best >= beta ? BOUND_LOWER : BOUND_EXACT;
+            table->store(game.hash(), bound == BOUND_UPPER ? -1 : static_cast<int>(bestMove), best, depth, bound);
+        }
+        return best;
+    }
+};
+
+#endif
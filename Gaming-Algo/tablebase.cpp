@@ -0,0 +1,49 @@
+#include <iostream>
+#include <thread>
+#include <chrono>
+#include "tic_tac_toe.h"
+#include "tablebase.h"
+#include "alpha_beta.h"
+
+int main() {
+    int threads = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+    TicTacToe game;
+
+    // Solve every position backwards from the finished games
+    RetrogradeSolver<TicTacToe> solver(game);
+    auto start = std::chrono::steady_clock::now();
+    solver.solve(threads);
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "Solved " << solver.legal << " positions in " << seconds << " s: " << solver.wins << " wins, "
+              << solver.losses << " losses, " << solver.draws << " draws, longest forced result " << solver.maxDistance
+              << " plies" << std::endl;
+
+    if (!solver.write("tictactoe.tb", false) || !solver.write("tictactoe.tbz", true)) {
+        std::cerr << "Could not write the tablebase" << std::endl;
+        return 1;
+    }
+
+    // Full search without the tablebase
+    AlphaBetaSearch<TicTacToe> plain(game);
+    int score = plain.search(9);
+    std::cout << "Alpha-beta: score " << score << ", best move " << plain.bestMove << ", "
+              << plain.nodes << " nodes" << std::endl;
+
+    // Same search probing each memory-mapped file
+    for (const char *path : {"tictactoe.tb", "tictactoe.tbz"}) {
+        Tablebase tablebase;
+        if (!tablebase.open(path)) {
+            std::cerr << "Could not open " << path << std::endl;
+            return 1;
+        }
+        AlphaBetaSearch<TicTacToe> probing(game);
+        probing.tablebase = &tablebase;
+        score = probing.search(9);
+        TBEntry root = tablebase.probe(game.index());
+        std::cout << "Alpha-beta with " << path << ": score " << score << ", best move " << probing.bestMove
+                  << ", " << probing.nodes << " nodes (root: "
+                  << (root.outcome == TB_WIN ? "win" : root.outcome == TB_LOSS ? "loss" : "draw") << ")" << std::endl;
+    }
+
+    return 0;
+}
@@ -0,0 +1,431 @@
+#ifndef TABLEBASE_H
+#define TABLEBASE_H
+
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <string>
+#include <fstream>
+#include <algorithm>
+#include <type_traits>
+#include <cstdint>
+#include <cstring>
+#include "game.h"
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+// Score of a tablebase win in zero plies; a win in d plies scores TB_WIN_SCORE - d, a loss in d
+// plies -(TB_WIN_SCORE - d), so faster wins and slower losses are preferred.
+const int TB_WIN_SCORE = SCORE_INF / 2;
+
+enum TBOutcome : uint8_t {
+    TB_DRAW = 0, // Also positions that cannot arise in a game
+    TB_WIN = 1,
+    TB_LOSS = 2
+};
+
+// Outcome for the side to move and the number of plies to the end of the game with best play
+// (the winner hurries, the loser delays)
+struct TBEntry {
+    TBOutcome outcome = TB_DRAW;
+    int distance = 0;
+
+    int score() const {
+        return outcome == TB_WIN ? TB_WIN_SCORE - distance : outcome == TB_LOSS ? distance - TB_WIN_SCORE : 0;
+    }
+};
+
+// Games that can be put in a tablebase also provide perfect indexing (see game.h):
+//
+//   uint64_t positionCount() const;     // Size of the index space
+//   uint64_t index() const;             // Index of the current position
+//   bool setIndex(uint64_t index);      // Set the position; false if it cannot arise in a game
+template <typename Game, typename = void>
+struct HasPerfectIndex : std::false_type {};
+
+template <typename Game>
+struct HasPerfectIndex<Game, decltype(void(std::declval<const Game &>().index()))> : std::true_type {};
+
+// One byte per position: 0 = draw, 1..127 = loss in (code - 1) plies, 128..255 = win in
+// (code - 128) plies. Longer distances saturate.
+namespace tbcode {
+    inline uint8_t loss(int distance) { return static_cast<uint8_t>(1 + std::min(distance, 126)); }
+    inline uint8_t win(int distance) { return static_cast<uint8_t>(128 + std::min(distance, 127)); }
+
+    inline TBEntry decode(uint8_t code) {
+        TBEntry entry;
+        if (code >= 128) {
+            entry.outcome = TB_WIN;
+            entry.distance = code - 128;
+        } else if (code >= 1) {
+            entry.outcome = TB_LOSS;
+            entry.distance = code - 1;
+        }
+        return entry;
+    }
+}
+
+// File layout: header, then either one byte per position or, when compressed, a table of block
+// offsets followed by each block of BLOCK_SIZE positions run-length encoded as (run - 1, code)
+// byte pairs. A compressed probe scans at most one block, so lookups stay constant time.
+struct TablebaseHeader {
+    char magic[8];
+    uint64_t positions;
+    uint32_t blockSize;
+    uint32_t compressed;
+};
+
+const char TB_MAGIC[8] = {'T', 'B', 'A', 'S', 'E', '0', '1', '\0'};
+
+// Retrograde analysis over every position of a Game with perfect indexing.
+//
+// One parallel pass over all indices finds the legal positions, counts each one's successors and
+// builds the reverse (predecessor) lists in CSR form. Terminal positions are scored from
+// Game::evaluate() (positive: the side to move has won). Then positions are resolved backwards in
+// order of distance, one parallel level at a time: a predecessor of a loss is a win one ply
+// further, and a position becomes a loss one ply further when its last unresolved successor turns
+// out to be a win. Whatever is never resolved is a draw.
+template <typename Game>
+class RetrogradeSolver {
+public:
+    explicit RetrogradeSolver(const Game &prototype) : prototype(prototype) {}
+
+    void solve(int numThreads) {
+        numThreads = std::max(1, numThreads);
+        uint64_t count = prototype.positionCount();
+        std::vector<std::atomic<uint32_t>> remaining(count);
+        std::vector<std::atomic<uint8_t>> codes(count);
+        std::vector<uint64_t> predecessorStart(count + 1, 0);
+        std::vector<std::vector<uint64_t>> frontiers(numThreads);
+        std::vector<uint64_t> legalCounts(numThreads, 0);
+
+        // Successor counts; the in-degree of each position goes to predecessorStart[index + 1]
+        std::vector<std::atomic<uint32_t>> inDegree(count);
+        parallelFor(count, numThreads, [&](uint64_t begin, uint64_t end, int t) {
+            Game game = prototype;
+            std::vector<typename Game::Move> moves;
+            for (uint64_t i = begin; i < end; i++) {
+                codes[i].store(0, std::memory_order_relaxed);
+                remaining[i].store(0, std::memory_order_relaxed);
+                if (!game.setIndex(i)) continue;
+                legalCounts[t]++;
+                moves.clear();
+                if (!game.isTerminal()) game.generateMoves(moves);
+                if (moves.empty()) {
+                    int value = game.evaluate();
+                    if (value != 0) {
+                        codes[i].store(value > 0 ? tbcode::win(0) : tbcode::loss(0), std::memory_order_relaxed);
+                        frontiers[t].push_back(i);
+                    }
+                    continue;
+                }
+                remaining[i].store(static_cast<uint32_t>(moves.size()), std::memory_order_relaxed);
+                for (auto move : moves) {
+                    game.makeMove(move);
+                    inDegree[game.index()].fetch_add(1, std::memory_order_relaxed);
+                    game.unmakeMove(move);
+                }
+            }
+        });
+        for (uint64_t i = 0; i < count; i++) {
+            predecessorStart[i + 1] = predecessorStart[i] + inDegree[i].load(std::memory_order_relaxed);
+        }
+
+        // Predecessor lists: each position writes itself into the lists of its successors
+        std::vector<uint64_t> predecessors(predecessorStart[count]);
+        std::vector<std::atomic<uint64_t>> cursor(count);
+        for (uint64_t i = 0; i < count; i++) {
+            cursor[i].store(predecessorStart[i], std::memory_order_relaxed);
+        }
+        parallelFor(count, numThreads, [&](uint64_t begin, uint64_t end, int) {
+            Game game = prototype;
+            std::vector<typename Game::Move> moves;
+            for (uint64_t i = begin; i < end; i++) {
+                if (remaining[i].load(std::memory_order_relaxed) == 0 || !game.setIndex(i)) continue;
+                moves.clear();
+                game.generateMoves(moves);
+                for (auto move : moves) {
+                    game.makeMove(move);
+                    predecessors[cursor[game.index()].fetch_add(1, std::memory_order_relaxed)] = i;
+                    game.unmakeMove(move);
+                }
+            }
+        });
+
+        // Backward levels: every position in the frontier is resolved at `distance`
+        std::vector<uint64_t> frontier;
+        for (auto &part : frontiers) {
+            frontier.insert(frontier.end(), part.begin(), part.end());
+            part.clear();
+        }
+        maxDistance = 0;
+        for (int distance = 0; !frontier.empty(); distance++) {
+            maxDistance = distance;
+            parallelFor(frontier.size(), numThreads, [&](uint64_t begin, uint64_t end, int t) {
+                for (uint64_t f = begin; f < end; f++) {
+                    uint64_t position = frontier[f];
+                    bool lost = tbcode::decode(codes[position].load(std::memory_order_relaxed)).outcome == TB_LOSS;
+                    for (uint64_t p = predecessorStart[position]; p < predecessorStart[position + 1]; p++) {
+                        uint64_t parent = predecessors[p];
+                        uint8_t unknown = 0;
+                        if (lost) {
+                            // Moving into a lost position wins
+                            if (codes[parent].compare_exchange_strong(unknown, tbcode::win(distance + 1))) {
+                                frontiers[t].push_back(parent);
+                            }
+                        } else if (remaining[parent].fetch_sub(1) == 1) {
+                            // Every move leads to a win for the opponent
+                            if (codes[parent].compare_exchange_strong(unknown, tbcode::loss(distance + 1))) {
+                                frontiers[t].push_back(parent);
+                            }
+                        }
+                    }
+                }
+            });
+            frontier.clear();
+            for (auto &part : frontiers) {
+                frontier.insert(frontier.end(), part.begin(), part.end());
+                part.clear();
+            }
+        }
+
+        table.resize(count);
+        wins = losses = 0;
+        for (uint64_t i = 0; i < count; i++) {
+            table[i] = codes[i].load(std::memory_order_relaxed);
+            TBOutcome outcome = tbcode::decode(table[i]).outcome;
+            if (outcome == TB_WIN) wins++;
+            if (outcome == TB_LOSS) losses++;
+        }
+        legal = 0;
+        for (uint64_t c : legalCounts) legal += c;
+        draws = legal - wins - losses;
+    }
+
+    TBEntry entry(uint64_t index) const {
+        return tbcode::decode(table[index]);
+    }
+
+    // Write the solved table; with `compress` blocks are run-length encoded
+    bool write(const std::string &path, bool compress) const {
+        std::ofstream out(path, std::ios::binary);
+        if (!out) return false;
+        TablebaseHeader header;
+        std::memcpy(header.magic, TB_MAGIC, sizeof(header.magic));
+        header.positions = table.size();
+        header.blockSize = BLOCK_SIZE;
+        header.compressed = compress ? 1 : 0;
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+        if (!compress) {
+            out.write(reinterpret_cast<const char*>(table.data()), table.size());
+            return static_cast<bool>(out);
+        }
+
+        uint64_t blocks = (table.size() + BLOCK_SIZE - 1) / BLOCK_SIZE;
+        std::vector<uint64_t> offsets(blocks + 1, 0);
+        std::vector<uint8_t> data;
+        for (uint64_t b = 0; b < blocks; b++) {
+            offsets[b] = data.size();
+            uint64_t end = std::min<uint64_t>(table.size(), (b + 1) * BLOCK_SIZE);
+            for (uint64_t i = b * BLOCK_SIZE; i < end;) {
+                uint64_t run = 1;
+                while (i + run < end && run < 256 && table[i + run] == table[i]) run++;
+                data.push_back(static_cast<uint8_t>(run - 1));
+                data.push_back(table[i]);
+                i += run;
+            }
+        }
+        offsets[blocks] = data.size();
+        out.write(reinterpret_cast<const char*>(offsets.data()), offsets.size() * sizeof(uint64_t));
+        out.write(reinterpret_cast<const char*>(data.data()), data.size());
+        return static_cast<bool>(out);
+    }
+
+    uint64_t legal = 0;  // Positions that can arise in a game
+    uint64_t wins = 0;
+    uint64_t losses = 0;
+    uint64_t draws = 0;
+    int maxDistance = 0; // Longest distance to the end of a won or lost position
+
+    static const uint32_t BLOCK_SIZE = 256;
+
+private:
+    const Game &prototype;
+    std::vector<uint8_t> table;
+
+    // Split [0, n) into one contiguous range per thread
+    template <typename Fn>
+    static void parallelFor(uint64_t n, int numThreads, Fn fn) {
+        std::vector<std::thread> workers;
+        uint64_t chunk = (n + numThreads - 1) / numThreads;
+        for (int t = 0; t < numThreads; t++) {
+            uint64_t begin = std::min(n, t * chunk);
+            uint64_t end = std::min(n, begin + chunk);
+            workers.emplace_back([&fn, begin, end, t]() {
+                fn(begin, end, t);
+            });
+        }
+        for (auto &worker : workers) {
+            worker.join();
+        }
+    }
+};
+
+// Read-only tablebase file, memory-mapped so that only the pages actually probed are loaded
+class Tablebase {
+public:
+    Tablebase() {}
+    ~Tablebase() { close(); }
+
+    Tablebase(const Tablebase &) = delete;
+    Tablebase &operator=(const Tablebase &) = delete;
+
+    bool open(const std::string &path) {
+        close();
+#if defined(__linux__)
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) return false;
+        struct stat info;
+        if (fstat(fd, &info) != 0 || static_cast<size_t>(info.st_size) < sizeof(TablebaseHeader)) {
+            ::close(fd);
+            return false;
+        }
+        size = static_cast<size_t>(info.st_size);
+        void *memory = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+        ::close(fd);
+        if (memory == MAP_FAILED) return false;
+        base = static_cast<const uint8_t*>(memory);
+        mapped = true;
+#else
+        std::ifstream in(path, std::ios::binary);
+        if (!in) return false;
+        buffer.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+        if (buffer.size() < sizeof(TablebaseHeader)) return false;
+        base = buffer.data();
+        size = buffer.size();
+#endif
+        std::memcpy(&header, base, sizeof(header));
+        if (std::memcmp(header.magic, TB_MAGIC, sizeof(header.magic)) != 0) {
+            close();
+            return false;
+        }
+        // The tables the header describes must lie inside the file, and the runs of every
+        // compressed block must cover exactly its positions, so probe() never leaves a block
+        const uint8_t *body = base + sizeof(TablebaseHeader);
+        uint64_t bodySize = size - sizeof(TablebaseHeader);
+        if (header.compressed) {
+            if (header.blockSize == 0) {
+                close();
+                return false;
+            }
+            uint64_t blocks = header.positions / header.blockSize + (header.positions % header.blockSize != 0);
+            if (blocks >= bodySize / sizeof(uint64_t)) {
+                close();
+                return false;
+            }
+            const uint64_t *table = reinterpret_cast<const uint64_t*>(body);
+            uint64_t dataSize = bodySize - (blocks + 1) * sizeof(uint64_t);
+            for (uint64_t b = 0; b < blocks; b++) {
+                if (table[b] > table[b + 1]) {
+                    close();
+                    return false;
+                }
+            }
+            if (table[blocks] > dataSize) {
+                close();
+                return false;
+            }
+            const uint8_t *data = body + (blocks + 1) * sizeof(uint64_t);
+            for (uint64_t b = 0; b < blocks; b++) {
+                uint64_t length = std::min<uint64_t>(header.blockSize, header.positions - b * header.blockSize);
+                uint64_t covered = 0;
+                if ((table[b + 1] - table[b]) % 2 != 0) {
+                    close();
+                    return false;
+                }
+                for (uint64_t run = table[b]; run < table[b + 1]; run += 2) {
+                    covered += static_cast<uint64_t>(data[run]) + 1;
+                }
+                if (covered != length) {
+                    close();
+                    return false;
+                }
+            }
+            offsets = table;
+            codes = data;
+        } else {
+            if (header.positions > bodySize) {
+                close();
+                return false;
+            }
+            codes = body;
+        }
+        return true;
+    }
+
+    void close() {
+#if defined(__linux__)
+        if (mapped) munmap(const_cast<uint8_t*>(base), size);
+#endif
+        mapped = false;
+        base = nullptr;
+        codes = nullptr;
+        offsets = nullptr;
+        header.positions = 0;
+    }
+
+    bool isOpen() const {
+        return codes != nullptr;
+    }
+
+    uint64_t positions() const {
+        return header.positions;
+    }
+
+    TBEntry probe(uint64_t index) const {
+        if (!header.compressed) {
+            return tbcode::decode(codes[index]);
+        }
+        uint64_t block = index / header.blockSize;
+        uint64_t skip = index % header.blockSize;
+        for (const uint8_t *run = codes + offsets[block]; ; run += 2) {
+            uint64_t length = static_cast<uint64_t>(run[0]) + 1;
+            if (skip < length) return tbcode::decode(run[1]);
+            skip -= length;
+        }
+    }
+
+    // Probe the game's current position; false if the game has no perfect index or is out of range
+    template <typename Game>
+    bool probe(const Game &game, TBEntry &out) const {
+        if constexpr (HasPerfectIndex<Game>::value) {
+            uint64_t index = game.index();
+            if (!codes || index >= header.positions) return false;
+            out = probe(index);
+            return true;
+        } else {
+            (void)game;
+            (void)out;
+            return false;
+        }
+    }
+
+private:
+    TablebaseHeader header{};
+    const uint8_t *base = nullptr;
+    const uint8_t *codes = nullptr;
+    const uint64_t *offsets = nullptr;
+    size_t size = 0;
+    bool mapped = false;
+#if !defined(__linux__)
+    std::vector<uint8_t> buffer;
+#endif
+};
+
+#endif
@@ -0,0 +1,97 @@
+#ifndef TIC_TAC_TOE_H
+#define TIC_TAC_TOE_H
+
+#include <vector>
+#include <cstdint>
+
+// Tic-tac-toe on two 9-bit boards, small enough to solve completely with a tablebase.
+// Squares are numbered 0..8 row by row; X moves first. Positions have a perfect index: the board
+// read as a base-3 number (0 = empty, 1 = X, 2 = O), so it supports tablebase generation.
+class TicTacToe {
+public:
+    typedef int Move;
+
+    static const int WIN_SCORE = 1000;
+
+    void generateMoves(std::vector<Move> &moves) const {
+        if (isTerminal()) return;
+        unsigned empty = ~(boards[0] | boards[1]) & FULL;
+        for (int square = 0; square < 9; square++) {
+            if (empty & (1u << square)) moves.push_back(square);
+        }
+    }
+
+    void makeMove(Move move) {
+        boards[sideToMove()] |= 1u << move;
+        ply++;
+    }
+
+    void unmakeMove(Move move) {
+        ply--;
+        boards[sideToMove()] &= ~(1u << move);
+    }
+
+    bool isTerminal() const {
+        return hasLine(boards[0]) || hasLine(boards[1]) || ply == 9;
+    }
+
+    // Lost if the opponent has just completed a line, otherwise even
+    int evaluate() const {
+        return hasLine(boards[1 - sideToMove()]) ? -WIN_SCORE : 0;
+    }
+
+    uint64_t hash() const {
+        return (index() + 1) * 0x9e3779b97f4a7c15ULL;
+    }
+
+    // Perfect indexing for tablebases: index() in [0, positionCount())
+    uint64_t positionCount() const {
+        return 19683; // 3^9
+    }
+
+    uint64_t index() const {
+        uint64_t result = 0;
+        for (int square = 8; square >= 0; square--) {
+            result = result * 3 + ((boards[0] >> square) & 1) + 2 * ((boards[1] >> square) & 1);
+        }
+        return result;
+    }
+
+    // Set the position with the given index; false if it cannot arise in a game
+    bool setIndex(uint64_t position) {
+        boards[0] = boards[1] = 0;
+        for (int square = 0; square < 9; square++) {
+            int cell = static_cast<int>(position % 3);
+            position /= 3;
+            if (cell) boards[cell - 1] |= 1u << square;
+        }
+        int crosses = __builtin_popcount(boards[0]);
+        int noughts = __builtin_popcount(boards[1]);
+        ply = crosses + noughts;
+        if (crosses != noughts && crosses != noughts + 1) return false;
+        // A completed line must have been the last move
+        if (hasLine(boards[0]) && (hasLine(boards[1]) || crosses != noughts + 1)) return false;
+        if (hasLine(boards[1]) && crosses != noughts) return false;
+        return true;
+    }
+
+private:
+    static const unsigned FULL = 0x1FF;
+
+    unsigned boards[2] = {0, 0}; // X, O
+    int ply = 0;
+
+    int sideToMove() const {
+        return ply % 2;
+    }
+
+    static bool hasLine(unsigned board) {
+        static const unsigned lines[8] = {0x7, 0x38, 0x1C0, 0x49, 0x92, 0x124, 0x111, 0x54};
+        for (unsigned line : lines) {
+            if ((board & line) == line) return true;
+        }
+        return false;
+    }
+};
+
+#endif
@@ -0,0 +1,265 @@
+#ifndef TRANSPOSITION_TABLE_H
+#define TRANSPOSITION_TABLE_H
+
+#include <atomic>
+#include <thread>
+#include <functional>
+#include <cstdint>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+#include <algorithm>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#endif
+
+// Kind of score stored for a position
+enum TTBound : uint8_t {
+    BOUND_NONE = 0,
+    BOUND_UPPER = 1, // Search failed low: score is an upper bound
+    BOUND_LOWER = 2, // Search failed high: score is a lower bound
+    BOUND_EXACT = 3
+};
+
+// Unpacked contents of a table entry
+struct TTData {
+    int move = -1;   // Best move, -1 if none
+    int score = 0;
+    int depth = 0;
+    TTBound bound = BOUND_NONE;
+};
+
+// Fixed-size transposition table shared by all search threads without locks.
+//
+// Entries are 16 bytes: (key ^ data, data), where data packs score, best move, depth, bound and
+// the search generation (age). A torn write from two threads leaves a pair that no longer XORs
+// back to the key, so readers see a miss instead of corrupt data. Four entries form a 64-byte,
+// cache-line aligned bucket, so a probe touches one cache line. When a bucket is full, the entry
+// with the lowest depth, counting entries from older searches as shallower, is replaced.
+class TranspositionTable {
+public:
+    // Allocate about `megabytes` of table (rounded down to a power of two number of buckets).
+    // With useHugePages the table is backed by huge pages where the OS supports it.
+    explicit TranspositionTable(size_t megabytes = 16, bool useHugePages = false) {
+        size_t bytes = std::max<size_t>(megabytes, 1) << 20;
+        bucketCount = 1;
+        while (bucketCount * 2 * sizeof(Bucket) <= bytes) {
+            bucketCount *= 2;
+        }
+        allocate(useHugePages);
+        clear();
+    }
+
+    ~TranspositionTable() {
+        release();
+    }
+
+    TranspositionTable(const TranspositionTable &) = delete;
+    TranspositionTable &operator=(const TranspositionTable &) = delete;
+
+    void clear() {
+        for (size_t b = 0; b < bucketCount; b++) {
+            for (auto &entry : buckets[b].entries) {
+                entry.check.store(0, std::memory_order_relaxed);
+                entry.data.store(0, std::memory_order_relaxed);
+            }
+        }
+        generation = 0;
+        for (auto &counter : counters) {
+            counter.probes.store(0, std::memory_order_relaxed);
+            counter.hits.store(0, std::memory_order_relaxed);
+        }
+    }
+
+    // Start a new search: entries stored from now on are newer than all existing ones
+    void newSearch() {
+        generation = (generation + 1) & AGE_MASK;
+    }
+
+    bool probe(uint64_t key, TTData &out) {
+        Counter &counter = localCounter();
+        counter.probes.fetch_add(1, std::memory_order_relaxed);
+
+        Bucket &bucket = buckets[key & (bucketCount - 1)];
+        for (auto &entry : bucket.entries) {
+            uint64_t data = entry.data.load(std::memory_order_relaxed);
+            uint64_t check = entry.check.load(std::memory_order_relaxed);
+            if ((check ^ data) == key && data != 0) {
+                out = unpack(data);
+                counter.hits.fetch_add(1, std::memory_order_relaxed);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void store(uint64_t key, int move, int score, int depth, TTBound bound) {
+        Bucket &bucket = buckets[key & (bucketCount - 1)];
+        Entry *victim = nullptr;
+        int victimWorth = 0;
+        for (auto &entry : bucket.entries) {
+            uint64_t data = entry.data.load(std::memory_order_relaxed);
+            uint64_t check = entry.check.load(std::memory_order_relaxed);
+
+            if ((check ^ data) == key && data != 0) {
+                // Same position: keep a clearly deeper result from the current search
+                TTData old = unpack(data);
+                int oldAge = static_cast<int>(data & AGE_MASK);
+                if (bound != BOUND_EXACT && oldAge == generation && old.depth > depth + 2) {
+                    return;
+                }
+                if (move < 0) move = old.move; // Keep the old best move if this search found none
+                victim = &entry;
+                break;
+            }
+
+            // Worth of keeping an entry: its depth, less 4 plies per search it has aged
+            int age = (generation - static_cast<int>(data & AGE_MASK)) & AGE_MASK;
+            int worth = data == 0 ? -1000 : static_cast<int>((data >> 8) & 0xFF) - 4 * age;
+            if (!victim || worth < victimWorth) {
+                victim = &entry;
+                victimWorth = worth;
+            }
+        }
+
+        uint64_t data = pack(move, score, depth, bound, generation);
+        victim->check.store(key ^ data, std::memory_order_relaxed);
+        victim->data.store(data, std::memory_order_relaxed);
+    }
+
+    // Fraction of probes that found their position
+    double hitRate() const {
+        uint64_t probes = 0;
+        uint64_t hits = 0;
+        for (const auto &counter : counters) {
+            probes += counter.probes.load(std::memory_order_relaxed);
+            hits += counter.hits.load(std::memory_order_relaxed);
+        }
+        return probes ? static_cast<double>(hits) / probes : 0.0;
+    }
+
+    uint64_t probes() const {
+        uint64_t total = 0;
+        for (const auto &counter : counters) total += counter.probes.load(std::memory_order_relaxed);
+        return total;
+    }
+
+    // Per-mille of sampled entries written by the current search
+    int usagePermille() const {
+        size_t sample = std::min<size_t>(bucketCount, 250);
+        int used = 0;
+        for (size_t b = 0; b < sample; b++) {
+            for (const auto &entry : buckets[b].entries) {
+                uint64_t data = entry.data.load(std::memory_order_relaxed);
+                if (data != 0 && static_cast<int>(data & AGE_MASK) == generation) used++;
+            }
+        }
+        return static_cast<int>(used * 1000 / (sample * ENTRIES_PER_BUCKET));
+    }
+
+    size_t sizeBytes() const {
+        return bucketCount * sizeof(Bucket);
+    }
+
+    bool usesHugePages() const {
+        return hugePages;
+    }
+
+private:
+    static const int ENTRIES_PER_BUCKET = 4;
+    static const int AGE_MASK = 0x3F;
+    static const int COUNTER_SHARDS = 16;
+
+    struct Entry {
+        std::atomic<uint64_t> check;
+        std::atomic<uint64_t> data;
+    };
+
+    struct alignas(64) Bucket {
+        Entry entries[ENTRIES_PER_BUCKET];
+    };
+
+    // Statistics are sharded by thread so that probing threads do not share a cache line
+    struct alignas(64) Counter {
+        std::atomic<uint64_t> probes{0};
+        std::atomic<uint64_t> hits{0};
+    };
+
+    Bucket *buckets = nullptr;
+    size_t bucketCount = 0;
+    bool hugePages = false;
+    bool mapped = false;
+    int generation = 0;
+    Counter counters[COUNTER_SHARDS];
+
+    Counter &localCounter() {
+        thread_local size_t shard = std::hash<std::thread::id>()(std::this_thread::get_id()) % COUNTER_SHARDS;
+        return counters[shard];
+    }
+
+    void allocate(bool useHugePages) {
+        size_t bytes = bucketCount * sizeof(Bucket);
+#if defined(__linux__)
+        if (useHugePages) {
+            // Explicit huge pages first; fall back to transparent huge pages
+            void *memory = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+            if (memory != MAP_FAILED) {
+                buckets = static_cast<Bucket*>(memory);
+                hugePages = true;
+                mapped = true;
+                constructBuckets();
+                return;
+            }
+            memory = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            if (memory != MAP_FAILED) {
+                hugePages = madvise(memory, bytes, MADV_HUGEPAGE) == 0;
+                buckets = static_cast<Bucket*>(memory);
+                mapped = true;
+                constructBuckets();
+                return;
+            }
+        }
+#else
+        (void)useHugePages;
+#endif
+        buckets = static_cast<Bucket*>(::operator new(bytes, std::align_val_t(64)));
+        constructBuckets();
+    }
+
+    void constructBuckets() {
+        for (size_t b = 0; b < bucketCount; b++) {
+            new (&buckets[b]) Bucket();
+        }
+    }
+
+    void release() {
+#if defined(__linux__)
+        if (mapped) {
+            munmap(buckets, bucketCount * sizeof(Bucket));
+            return;
+        }
+#endif
+        ::operator delete(buckets, std::align_val_t(64));
+    }
+
+    // data layout: score (32) | move + 1 (16) | depth (8) | bound (2) | age (6); never zero once stored
+    static uint64_t pack(int move, int score, int depth, TTBound bound, int age) {
+        return (static_cast<uint64_t>(static_cast<uint32_t>(score)) << 32) |
+               (static_cast<uint64_t>((move + 1) & 0xFFFF) << 16) |
+               (static_cast<uint64_t>(depth & 0xFF) << 8) |
+               (static_cast<uint64_t>(bound) << 6) |
+               static_cast<uint64_t>(age & AGE_MASK);
+    }
+
+    static TTData unpack(uint64_t data) {
+        TTData out;
+        out.score = static_cast<int32_t>(static_cast<uint32_t>(data >> 32));
+        out.move = static_cast<int>((data >> 16) & 0xFFFF) - 1;
+        out.depth = static_cast<int>((data >> 8) & 0xFF);
+        out.bound = static_cast<TTBound>((data >> 6) & 0x3);
+        return out;
+    }
+};
+
+#endif
@@ -4,115 +4,558 @@
 #include <string>
 #include <limits>
 #include <algorithm>
-#include <set>
+#include <queue>
+#include <atomic>
+#include <future>
+#include <thread>
+#include <functional>
 
-// Structure to represent a node in the graph
-class Node {
-public:
-    std::string name;
-    std::vector<std::vector<std::pair<Node*, int>>> successors; // Each vector represents a group (AND/OR) with costs
+const long long INF_COST = std::numeric_limits<long long>::max();
+
+// A node of the AND/OR graph. Nodes live in a flat arena and refer to each other by index.
+struct NodeRecord {
+    int heuristic;      // Estimated cost before expansion (and the cost of a terminal leaf)
+    long long cost;     // Current cost estimate (exact once solved)
+    int firstGroup;     // Index of the node's first successor group
+    int groupCount;     // Number of successor groups (0 for a terminal leaf)
+    int bestGroup;      // Currently marked (cheapest) group, -1 if none
+    bool expanded;
     bool isSolved;
-    bool isOrNode; // True if OR node, false if AND node
-    int cost; // The cost of the node
+};
 
-    Node(std::string n, bool orNode = true) : name(n), isSolved(false), isOrNode(orNode), cost(std::numeric_limits<int>::max()) {}
+// A successor group is an AND connector: all of its children must be solved.
+// A node with several groups is an OR over them.
+struct GroupRecord {
+    int node;       // Node the group belongs to
+    int firstEdge;  // Index of the group's first edge
+    int edgeCount;
+};
 
-    // Add a set of successors to this node (each vector represents a group of AND/OR successors)
-    void addSuccessors(const std::vector<std::pair<Node*, int>>& group) {
-        successors.push_back(group);
-    }
+// An edge from a group to one of its children, with the transition cost
+struct EdgeRecord {
+    int child;
+    int cost;
 };
 
-// Function to print the path and cost of the solution
-void printSolution(Node* node) {
-    if (!node) return;
-    std::cout << "Node: " << node->name << " | Cost: " << node->cost << std::endl;
-}
+// The solution subgraph found by AO*: every node it contains with the group chosen for it
+struct SolutionGraph {
+    long long cost = INF_COST;
+    std::vector<std::pair<int, int>> nodes; // (node, chosen group or -1 for a leaf)
+};
 
 // Heuristic function (simple example: length of the node's name)
-int heuristic(Node* node) {
-    return node->name.length();
+int heuristic(const std::string &name) {
+    return static_cast<int>(name.length());
 }
 
-// AO* algorithm
-int aoStar(Node* node, std::set<Node*>& explored) {
-    // If node is solved or already explored, return its cost
-    if (node->isSolved) return node->cost;
-    if (explored.find(node) != explored.end()) return node->cost;
+class AndOrGraph {
+public:
+    std::vector<std::string> names;
+    std::vector<NodeRecord> nodes;
+    std::vector<GroupRecord> groups;
+    std::vector<EdgeRecord> edges;
+
+    // Add a node using the default heuristic
+    int addNode(const std::string &name) {
+        return addNode(name, heuristic(name));
+    }
 
-    explored.insert(node); // Add the current node to the explored list
+    int addNode(const std::string &name, int h) {
+        names.push_back(name);
+        nodes.push_back({h, h, 0, 0, -1, false, false});
+        finalized = false;
+        return static_cast<int>(nodes.size()) - 1;
+    }
 
-    // If it has no successors, it is a leaf node
-    if (node->successors.empty()) {
-        node->cost = heuristic(node);
-        node->isSolved = true;
-        return node->cost;
+    // Add an AND group of (child, transition cost) successors to a node
+    void addSuccessors(int node, const std::vector<std::pair<int, int>> &group) {
+        groups.push_back({node, static_cast<int>(edges.size()), static_cast<int>(group.size())});
+        for (const auto &successor : group) {
+            edges.push_back({successor.first, successor.second});
+        }
+        finalized = false;
     }
 
-    // Explore all successor groups to find the minimum cost path
-    int minCost = std::numeric_limits<int>::max();
-    std::vector<Node*> bestGroup;
+    // Lay out groups contiguously per node, build parent links and a topological order.
+    // Returns false if the graph has a cycle (AO* here requires a DAG).
+    bool finalize() {
+        if (finalized) return true;
+        size_t n = nodes.size();
 
-    // Explore each AND/OR group
-    for (const auto& group : node->successors) {
-        int groupCost = 0;
-        std::vector<Node*> groupNodes;
-        for (const auto& successor : group) {
-            int childCost = aoStar(successor.first, explored); // Recursively call AO* on the child
-            groupCost += childCost + successor.second; // Add the transition cost
-            groupNodes.push_back(successor.first);
+        // Counting sort of groups by owning node
+        std::vector<int> groupOffsets(n + 1, 0);
+        for (const auto &group : groups) groupOffsets[group.node + 1]++;
+        for (size_t i = 0; i < n; i++) groupOffsets[i + 1] += groupOffsets[i];
+        std::vector<GroupRecord> sorted(groups.size());
+        std::vector<int> fill(groupOffsets.begin(), groupOffsets.end() - 1);
+        for (const auto &group : groups) sorted[fill[group.node]++] = group;
+        groups.swap(sorted);
+        for (size_t i = 0; i < n; i++) {
+            nodes[i].firstGroup = groupOffsets[i];
+            nodes[i].groupCount = groupOffsets[i + 1] - groupOffsets[i];
         }
 
-        // If this group's cost is lower than the current minimum, update it
-        if (groupCost < minCost) {
-            minCost = groupCost;
-            bestGroup = groupNodes;
+        // Parent links (reverse edges), used to revise ancestors
+        parentOffsets.assign(n + 1, 0);
+        for (const auto &group : groups) {
+            for (int e = group.firstEdge; e < group.firstEdge + group.edgeCount; e++) {
+                parentOffsets[edges[e].child + 1]++;
+            }
         }
+        for (size_t i = 0; i < n; i++) parentOffsets[i + 1] += parentOffsets[i];
+        parents.assign(parentOffsets[n], 0);
+        fill.assign(parentOffsets.begin(), parentOffsets.end() - 1);
+        for (const auto &group : groups) {
+            for (int e = group.firstEdge; e < group.firstEdge + group.edgeCount; e++) {
+                parents[fill[edges[e].child]++] = group.node;
+            }
+        }
+
+        // Kahn's algorithm: parents get a lower rank than their children
+        std::vector<int> pendingParents(n);
+        for (size_t i = 0; i < n; i++) pendingParents[i] = parentOffsets[i + 1] - parentOffsets[i];
+        std::vector<int> order;
+        order.reserve(n);
+        for (size_t i = 0; i < n; i++) {
+            if (pendingParents[i] == 0) order.push_back(static_cast<int>(i));
+        }
+        for (size_t i = 0; i < order.size(); i++) {
+            const NodeRecord &node = nodes[order[i]];
+            for (int g = node.firstGroup; g < node.firstGroup + node.groupCount; g++) {
+                for (int e = groups[g].firstEdge; e < groups[g].firstEdge + groups[g].edgeCount; e++) {
+                    if (--pendingParents[edges[e].child] == 0) order.push_back(edges[e].child);
+                }
+            }
+        }
+        if (order.size() != n) {
+            return false;
+        }
+        topoRank.assign(n, 0);
+        for (size_t i = 0; i < n; i++) topoRank[order[i]] = static_cast<int>(i);
+
+        finalized = true;
+        return true;
     }
 
-    // Update the node's cost to the minimum found
-    node->cost = minCost;
-    node->isSolved = true; // Once a node is solved, it doesn't need to be explored again
-    explored.erase(node);  // Remove from explored set as it is fully solved
+    // AO* as an iterative expand-and-revise loop.
+    // Each iteration expands every unexpanded tip of the current best partial solution (looking
+    // ahead below the tips, up to the size of the partial solution, so deep graphs do not pay a
+    // full trace and revision per node), then revises costs bottom-up through the affected
+    // ancestors. Solved nodes keep their state, so subproblems shared by several parents (or
+    // later queries) are solved only once.
+    SolutionGraph aoStar(int root) {
+        SolutionGraph solution;
+        if (!finalize()) {
+            std::cout << "AO* requires an acyclic AND/OR graph." << std::endl;
+            return solution;
+        }
+        if (stamp.size() != nodes.size()) stamp.assign(nodes.size(), 0);
 
-    return node->cost;
-}
+        while (!nodes[root].isSolved) {
+            size_t traced = 0;
+            std::vector<int> tips = collectTips(root, traced);
+            if (tips.empty()) break;
+
+            expandTips(tips, std::max(tips.size(), traced));
+            reviseCosts();
+        }
+
+        solution.cost = nodes[root].cost;
+        solution.nodes = collectSolution(root);
+        return solution;
+    }
+
+    // Incremental revision: change a node's heuristic estimate. For a terminal leaf this is its
+    // cost. The change is propagated up through the parent links only as far as costs actually
+    // change, switching marked groups where needed; nodes whose marked group becomes unsolved are
+    // reopened, and the next aoStar() call continues from there instead of from scratch.
+    void updateHeuristic(int id, int h) {
+        nodes[id].heuristic = h;
+        if (!finalized) {
+            nodes[id].cost = h;
+            return;
+        }
+        if (nodes[id].groupCount == 0 || !nodes[id].expanded) {
+            // Leaves and unexpanded nodes are costed by their heuristic alone
+            long long oldCost = nodes[id].cost;
+            nodes[id].cost = h;
+            if (nodes[id].groupCount == 0) nodes[id].isSolved = true;
+            if (nodes[id].cost == oldCost) return;
+            bool cheaper = nodes[id].cost < oldCost;
+            for (int p = parentOffsets[id]; p < parentOffsets[id + 1]; p++) {
+                int parent = parents[p];
+                if (nodes[parent].expanded && (cheaper || inMarkedGroup(parent, id))) scheduleRevision(parent);
+            }
+        }
+        reviseCosts();
+    }
+
+    // Change the cost of a terminal leaf (e.g. from a new live estimate)
+    void updateLeafCost(int id, int cost) {
+        updateHeuristic(id, cost);
+    }
+
+    // Task-parallel AO*: AND siblings and OR alternatives are solved concurrently on up to
+    // numThreads threads. Exact costs are memoized per node with atomics, so subproblems shared by
+    // several parents are reused across threads. Each OR node keeps the cost of its best finished
+    // alternative, and groups whose partial cost reaches it are cut off.
+    // The search recurses along the graph depth; use aoStar() for very deep graphs.
+    SolutionGraph parallelAoStar(int root, int numThreads) {
+        SolutionGraph solution;
+        if (!finalize()) {
+            std::cout << "AO* requires an acyclic AND/OR graph." << std::endl;
+            return solution;
+        }
+        if (stamp.size() != nodes.size()) stamp.assign(nodes.size(), 0);
+
+        memoCost = std::vector<std::atomic<long long>>(nodes.size());
+        memoGroup = std::vector<std::atomic<int>>(nodes.size());
+        memoLower = std::vector<std::atomic<long long>>(nodes.size());
+        for (size_t i = 0; i < nodes.size(); i++) {
+            memoCost[i].store(INF_COST, std::memory_order_relaxed);
+            memoGroup[i].store(-1, std::memory_order_relaxed);
+            memoLower[i].store(0, std::memory_order_relaxed);
+        }
+        spareThreads.store(std::max(0, numThreads - 1));
+
+        solveBounded(root, INF_COST);
+
+        // Copy the memoized results into the arena so the solution subgraph can be read back
+        for (size_t i = 0; i < nodes.size(); i++) {
+            long long cost = memoCost[i].load();
+            if (cost == INF_COST) continue;
+            nodes[i].cost = cost;
+            nodes[i].bestGroup = memoGroup[i].load();
+            nodes[i].expanded = true;
+            nodes[i].isSolved = true;
+        }
+        solution.cost = nodes[root].cost;
+        solution.nodes = collectSolution(root);
+        return solution;
+    }
+
+    // Print every node of the solution subgraph with its cost and chosen successors
+    void printSolution(const SolutionGraph &solution) {
+        for (const auto &entry : solution.nodes) {
+            std::cout << "Node: " << names[entry.first] << " | Cost: " << nodes[entry.first].cost;
+            if (entry.second >= 0) {
+                const GroupRecord &group = groups[entry.second];
+                std::cout << " | Solved via: ";
+                for (int e = group.firstEdge; e < group.firstEdge + group.edgeCount; e++) {
+                    std::cout << (e > group.firstEdge ? " AND " : "") << names[edges[e].child];
+                }
+            }
+            std::cout << std::endl;
+        }
+    }
+
+protected:
+    bool finalized = false;
+    std::vector<int> parentOffsets;
+    std::vector<int> parents;
+    std::vector<int> topoRank;
+    std::vector<unsigned> stamp;  // Visit marks for graph walks, so shared nodes are visited once
+    unsigned currentStamp = 0;
+
+    // Revision worklist ordered by topological rank, deepest nodes first
+    std::priority_queue<std::pair<int, int>> revisionQueue;
+    std::vector<char> queued;
+
+    // Recompute a node's cost and marked group from its children's current estimates.
+    // Returns true if the cost or solved flag changed, i.e. the parents need revising too.
+    bool recompute(int id) {
+        NodeRecord &node = nodes[id];
+        long long oldCost = node.cost;
+        bool oldSolved = node.isSolved;
+
+        if (node.groupCount == 0) {
+            // Terminal leaf: its cost is the heuristic value
+            node.cost = node.heuristic;
+            node.isSolved = true;
+        } else {
+            long long minCost = INF_COST;
+            int bestGroup = -1;
+            bool bestSolved = false;
+            for (int g = node.firstGroup; g < node.firstGroup + node.groupCount; g++) {
+                long long groupCost = 0;
+                bool groupSolved = true;
+                for (int e = groups[g].firstEdge; e < groups[g].firstEdge + groups[g].edgeCount; e++) {
+                    const NodeRecord &child = nodes[edges[e].child];
+                    groupCost += child.cost + edges[e].cost; // Add the transition cost
+                    groupSolved = groupSolved && child.isSolved;
+                }
+                // Prefer the cheaper group; on ties prefer one that is already solved
+                if (groupCost < minCost || (groupCost == minCost && groupSolved && !bestSolved)) {
+                    minCost = groupCost;
+                    bestGroup = g;
+                    bestSolved = groupSolved;
+                }
+            }
+            node.cost = minCost;
+            node.bestGroup = bestGroup;
+            node.isSolved = bestSolved;
+        }
+        return node.cost != oldCost || node.isSolved != oldSolved;
+    }
+
+    void scheduleRevision(int id) {
+        if (queued.size() != nodes.size()) queued.assign(nodes.size(), 0);
+        if (queued[id]) return;
+        queued[id] = 1;
+        revisionQueue.push({topoRank[id], id});
+    }
+
+    // Revise queued nodes children-first, propagating changes to expanded parents.
+    // A parent only has to be revisited if the node lies in its marked group, or if the node got
+    // cheaper and might make another group of the parent the best one.
+    void reviseCosts() {
+        while (!revisionQueue.empty()) {
+            int id = revisionQueue.top().second;
+            revisionQueue.pop();
+            queued[id] = 0;
+            long long oldCost = nodes[id].cost;
+            if (!recompute(id)) continue;
+            bool cheaper = nodes[id].cost < oldCost;
+            for (int p = parentOffsets[id]; p < parentOffsets[id + 1]; p++) {
+                int parent = parents[p];
+                if (nodes[parent].expanded && (cheaper || inMarkedGroup(parent, id))) scheduleRevision(parent);
+            }
+        }
+    }
+
+    bool inMarkedGroup(int parent, int child) {
+        int g = nodes[parent].bestGroup;
+        if (g < 0) return false;
+        for (int e = groups[g].firstEdge; e < groups[g].firstEdge + groups[g].edgeCount; e++) {
+            if (edges[e].child == child) return true;
+        }
+        return false;
+    }
+
+    // Expand the tips, then keep expanding unexpanded children of their marked groups until the
+    // budget is used. Expanding a few extra nodes never affects optimality, only the work done.
+    void expandTips(std::vector<int> &stack, size_t budget) {
+        size_t expandedCount = 0;
+        while (!stack.empty() && expandedCount < budget) {
+            int id = stack.back();
+            stack.pop_back();
+            if (nodes[id].expanded) continue;
+            nodes[id].expanded = true;
+            expandedCount++;
+
+            // Mark the node's best group from its children's estimates, and let parents revise
+            recompute(id);
+            for (int p = parentOffsets[id]; p < parentOffsets[id + 1]; p++) {
+                if (nodes[parents[p]].expanded) scheduleRevision(parents[p]);
+            }
+
+            const NodeRecord &node = nodes[id];
+            if (node.isSolved || node.bestGroup < 0) continue;
+            const GroupRecord &group = groups[node.bestGroup];
+            for (int e = group.firstEdge; e < group.firstEdge + group.edgeCount; e++) {
+                if (!nodes[edges[e].child].expanded) stack.push_back(edges[e].child);
+            }
+        }
+    }
+
+    // Unexpanded nodes reachable from the root through marked groups of unsolved nodes
+    std::vector<int> collectTips(int root, size_t &traced) {
+        std::vector<int> tips;
+        std::vector<int> stack = {root};
+        currentStamp++;
+        stamp[root] = currentStamp;
+        while (!stack.empty()) {
+            int id = stack.back();
+            stack.pop_back();
+            traced++;
+            const NodeRecord &node = nodes[id];
+            if (!node.expanded) {
+                tips.push_back(id);
+                continue;
+            }
+            if (node.isSolved || node.bestGroup < 0) continue;
+            const GroupRecord &group = groups[node.bestGroup];
+            for (int e = group.firstEdge; e < group.firstEdge + group.edgeCount; e++) {
+                int child = edges[e].child;
+                if (!nodes[child].isSolved && stamp[child] != currentStamp) {
+                    stamp[child] = currentStamp;
+                    stack.push_back(child);
+                }
+            }
+        }
+        return tips;
+    }
+
+    // Memo for parallelAoStar: exact cost (INF_COST until known), best group, and the largest
+    // lower bound learned from cut-off attempts, so a shared node is not re-searched in vain
+    std::vector<std::atomic<long long>> memoCost;
+    std::vector<std::atomic<int>> memoGroup;
+    std::vector<std::atomic<long long>> memoLower;
+    std::atomic<int> spareThreads{0};  // Threads that may still be spawned for subtasks
+
+    // Run all tasks, handing them to new threads while spare threads remain
+    void runTasks(const std::vector<std::function<void()>> &tasks) {
+        std::vector<std::future<void>> futures;
+        for (size_t i = 0; i + 1 < tasks.size(); i++) {
+            if (spareThreads.fetch_sub(1) > 0) {
+                futures.push_back(std::async(std::launch::async, [this, &tasks, i]() {
+                    tasks[i]();
+                    spareThreads.fetch_add(1);
+                }));
+            } else {
+                spareThreads.fetch_add(1);
+                tasks[i]();
+            }
+        }
+        if (!tasks.empty()) tasks.back()();
+        for (auto &future : futures) future.get();
+    }
+
+    // Solve a node if its cost is below bound. Returns the exact cost (memoized) when it is below
+    // bound; otherwise returns some value >= bound, meaning the caller can cut this branch.
+    long long solveBounded(int id, long long bound) {
+        long long known = memoCost[id].load(std::memory_order_acquire);
+        if (known != INF_COST) return known;
+        long long lower = memoLower[id].load(std::memory_order_relaxed);
+        if (lower >= bound) return lower;
+
+        const NodeRecord &node = nodes[id];
+        if (node.groupCount == 0) {
+            // Terminal leaf: its cost is the heuristic value
+            memoCost[id].store(node.heuristic, std::memory_order_release);
+            return node.heuristic;
+        }
+
+        // Cost of the best finished OR alternative, shared by the groups running in parallel
+        std::atomic<long long> best{bound};
+        std::atomic<int> bestGroup{-1};
+
+        std::vector<std::function<void()>> alternatives;
+        for (int g = node.firstGroup; g < node.firstGroup + node.groupCount; g++) {
+            alternatives.push_back([this, g, &best, &bestGroup]() {
+                long long cost = solveGroup(g, best.load());
+                long long current = best.load();
+                while (cost < current) {
+                    if (best.compare_exchange_weak(current, cost)) {
+                        bestGroup.store(g);
+                        break;
+                    }
+                }
+            });
+        }
+        runTasks(alternatives);
+
+        long long cost = best.load();
+        if (cost >= bound) {
+            // Cut off: cost is only a lower bound, remember it for later attempts
+            long long current = memoLower[id].load(std::memory_order_relaxed);
+            while (cost > current && !memoLower[id].compare_exchange_weak(current, cost, std::memory_order_relaxed)) {
+            }
+            return cost;
+        }
+
+        // Every other group was either finished or cut at a bound >= cost, so cost is exact.
+        // Another thread may have solved the same node meanwhile; both results are equal.
+        memoGroup[id].store(bestGroup.load(), std::memory_order_relaxed);
+        memoCost[id].store(cost, std::memory_order_release);
+        return cost;
+    }
+
+    // Cost of an AND group if it is below bound, otherwise some value >= bound
+    long long solveGroup(int g, long long bound) {
+        const GroupRecord &group = groups[g];
+        long long edgeCosts = 0;
+        for (int e = group.firstEdge; e < group.firstEdge + group.edgeCount; e++) {
+            edgeCosts += edges[e].cost;
+        }
+        if (edgeCosts >= bound) return edgeCosts;
+
+        // Solve all children concurrently; each may use whatever budget is left after the edges
+        std::vector<long long> childCosts(group.edgeCount, 0);
+        std::atomic<long long> total{edgeCosts};
+        std::vector<std::function<void()>> children;
+        for (int i = 0; i < group.edgeCount; i++) {
+            children.push_back([this, &group, &childCosts, &total, bound, i]() {
+                long long spent = total.load();
+                if (spent >= bound) return; // A sibling already pushed the group over the bound
+                long long cost = solveBounded(edges[group.firstEdge + i].child, bound - spent);
+                childCosts[i] = cost;
+                total.fetch_add(std::min(cost, bound));
+            });
+        }
+        runTasks(children);
+
+        long long cost = edgeCosts;
+        for (long long childCost : childCosts) {
+            cost += childCost;
+            if (cost >= bound) return bound;
+        }
+        return total.load() >= bound ? bound : cost;
+    }
+
+    // The solution subgraph: every node reachable from the root through marked groups
+    std::vector<std::pair<int, int>> collectSolution(int root) {
+        std::vector<std::pair<int, int>> result;
+        std::vector<int> stack = {root};
+        currentStamp++;
+        stamp[root] = currentStamp;
+        while (!stack.empty()) {
+            int id = stack.back();
+            stack.pop_back();
+            int g = nodes[id].groupCount > 0 ? nodes[id].bestGroup : -1;
+            result.push_back({id, g});
+            if (g < 0) continue;
+            for (int e = groups[g].firstEdge; e < groups[g].firstEdge + groups[g].edgeCount; e++) {
+                int child = edges[e].child;
+                if (stamp[child] != currentStamp) {
+                    stamp[child] = currentStamp;
+                    stack.push_back(child);
+                }
+            }
+        }
+        return result;
+    }
+};
 
 int main() {
+    AndOrGraph graph;
+
     // Create graph nodes
-    Node* A = new Node("A", true);  // Root node (OR node)
-    Node* B = new Node("B", true);  // OR node
-    Node* C = new Node("C", false); // AND node
-    Node* D = new Node("D", true);  // OR node
-    Node* E = new Node("E", true);  // OR node
-    Node* F = new Node("F", true);  // OR node
-    Node* G = new Node("G", false); // AND node
-    Node* H = new Node("H", true);  // OR node
-
-    // Define successors (AND/OR structure)
-    A->addSuccessors({{B, 1}, {C, 1}}); // A -> (B, C) (OR)
-    B->addSuccessors({{D, 2}, {E, 3}}); // B -> (D, E) (OR)
-    C->addSuccessors({{F, 1}, {G, 1}}); // C -> (F AND G)
-    D->addSuccessors({{H, 4}});         // D -> (H)
-    G->addSuccessors({{H, 2}});         // G -> (H)
+    int A = graph.addNode("A"); // Root node
+    int B = graph.addNode("B");
+    int C = graph.addNode("C");
+    int D = graph.addNode("D");
+    int E = graph.addNode("E");
+    int F = graph.addNode("F");
+    int G = graph.addNode("G");
+    int H = graph.addNode("H");
+
+    // Define successors: separate groups are OR alternatives, one group is an AND connector
+    graph.addSuccessors(A, {{B, 1}});         // A -> B
+    graph.addSuccessors(A, {{C, 1}});         //   OR C
+    graph.addSuccessors(B, {{D, 2}});         // B -> D
+    graph.addSuccessors(B, {{E, 3}});         //   OR E
+    graph.addSuccessors(C, {{F, 1}, {G, 1}}); // C -> (F AND G)
+    graph.addSuccessors(D, {{H, 4}});         // D -> (H)
+    graph.addSuccessors(G, {{H, 2}});         // G -> (H), H is shared with D
 
     // Run AO* starting from the root node A
-    std::set<Node*> explored;
-    int totalCost = aoStar(A, explored);
-
-    // Print the final solution path and cost
-    std::cout << "Optimal cost for reaching the goal: " << totalCost << std::endl;
-    printSolution(A);
-
-    // Clean up dynamically allocated nodes
-    delete A;
-    delete B;
-    delete C;
-    delete D;
-    delete E;
-    delete F;
-    delete G;
-    delete H;
+    SolutionGraph solution = graph.aoStar(A);
+
+    // Print the final solution subgraph and cost
+    std::cout << "Optimal cost for reaching the goal: " << solution.cost << std::endl;
+    graph.printSolution(solution);
+
+    // A leaf's live cost estimate changes: revise only its ancestors and continue AO* from there
+    graph.updateLeafCost(E, 10);
+    SolutionGraph revised = graph.aoStar(A);
+    std::cout << "Optimal cost after E changed to 10: " << revised.cost << std::endl;
+    graph.printSolution(revised);
+
+    // Solve the same graph again with AND siblings and OR alternatives evaluated in parallel
+    SolutionGraph parallelSolution = graph.parallelAoStar(A, static_cast<int>(std::thread::hardware_concurrency()));
+    std::cout << "Optimal cost (parallel AO*): " << parallelSolution.cost << std::endl;
+    graph.printSolution(parallelSolution);
 
     return 0;
 }
@@ -5,6 +5,9 @@
 #include <string>
 #include <set>
 #include <limits>
+#include <algorithm>
+#include <thread>
+#include <cmath>
 
 class Graph {
 public:
@@ -70,6 +73,95 @@ public:
         std::cout << "No path found from " << source << " to " << goal << ".\n";
     }
 
+    // K-Best-First Search: pop the K best frontier nodes per iteration and expand them together.
+    // Children are generated on numThreads threads and merged into the frontier in one batch,
+    // which amortizes heap work and lets the search step off heuristic plateaus faster.
+    void kBestFirstSearch(const std::string &source, const std::string &goal, size_t k, int numThreads) {
+        typedef std::pair<int, std::string> FrontierEntry; // (heuristic, node)
+        typedef std::pair<FrontierEntry, std::string> Child; // (frontier entry, parent)
+
+        // Frontier kept as a min-heap in a plain vector, so children can be merged in bulk
+        std::vector<FrontierEntry> frontier;
+        std::set<std::string> visited;
+        std::unordered_map<std::string, std::string> cameFrom;  // For reconstructing the path
+
+        frontier.push_back({heuristic(source, goal), source});
+        k = std::max<size_t>(1, k);
+        numThreads = std::max(1, numThreads);
+
+        std::cout << "Starting " << k << "-Best-First Search from " << source << " to " << goal << "...\n";
+
+        while (!frontier.empty()) {
+            // Pop up to K unvisited nodes
+            std::vector<std::string> batch;
+            while (!frontier.empty() && batch.size() < k) {
+                std::pop_heap(frontier.begin(), frontier.end(), std::greater<>());
+                std::string node = frontier.back().second;
+                frontier.pop_back();
+                if (visited.find(node) != visited.end()) continue;
+                visited.insert(node);
+                batch.push_back(node);
+            }
+
+            // If the goal is among them, reconstruct and print the path
+            for (const auto &node : batch) {
+                if (node == goal) {
+                    std::cout << "Goal reached: " << goal << std::endl;
+                    reconstructPath(cameFrom, source, goal);
+                    return;
+                }
+            }
+
+            // Expand the whole batch; each thread fills its own child list
+            size_t threads = std::min<size_t>(numThreads, batch.size());
+            std::vector<std::vector<Child>> children(threads);
+            auto expand = [&](size_t t) {
+                for (size_t i = t; i < batch.size(); i += threads) {
+                    auto it = adjList.find(batch[i]);
+                    if (it == adjList.end()) continue;
+                    for (const auto &neighbor : it->second) {
+                        if (visited.find(neighbor.first) == visited.end()) {
+                            children[t].push_back({{heuristic(neighbor.first, goal), neighbor.first}, batch[i]});
+                        }
+                    }
+                }
+            };
+            if (threads > 1) {
+                std::vector<std::thread> workers;
+                for (size_t t = 1; t < threads; t++) {
+                    workers.emplace_back(expand, t);
+                }
+                expand(0);
+                for (auto &worker : workers) {
+                    worker.join();
+                }
+            } else if (threads == 1) {
+                expand(0);
+            }
+
+            // Merge all children into the frontier in one batched heap operation
+            size_t added = 0;
+            for (const auto &list : children) {
+                for (const auto &child : list) {
+                    frontier.push_back(child.first);
+                    cameFrom[child.first.second] = child.second;  // Track the path
+                    added++;
+                }
+            }
+            size_t oldSize = frontier.size() - added;
+            if (added * std::log2(static_cast<double>(frontier.size()) + 1) > frontier.size()) {
+                // Rebuilding is linear, cheaper than sifting up many children one by one
+                std::make_heap(frontier.begin(), frontier.end(), std::greater<>());
+            } else {
+                for (size_t i = oldSize; i < frontier.size(); i++) {
+                    std::push_heap(frontier.begin(), frontier.begin() + i + 1, std::greater<>());
+                }
+            }
+        }
+
+        std::cout << "No path found from " << source << " to " << goal << ".\n";
+    }
+
     // Function to reconstruct the path from the source to the goal
     void reconstructPath(const std::unordered_map<std::string, std::string> &cameFrom, const std::string &start, const std::string &goal) {
         std::vector<std::string> path;
@@ -112,5 +204,8 @@ int main() {
 
     graph.bestFirstSearch(source, goal);
 
+    // Same search expanding the 3 best frontier nodes per iteration on up to 2 threads
+    graph.kBestFirstSearch(source, goal, 3, 2);
+
     return 0;
 }
@@ -5,16 +5,40 @@
 #include <queue>
 #include <set>
 #include <cmath>
+#include <atomic>
+#include <chrono>
+#include <memory>
 #include <cstdlib>  // For system()
+#include "../query_cache/query_cache.h"
+#include "../search_trace/search_trace.h"
 
 class Graph {
 public:
     std::unordered_map<std::string, std::vector<std::pair<std::string, int>>> adjList;
+    std::atomic<uint64_t> version{0}; // Bumped by every change to the graph, so cached results go stale
+    QueryCache *cache = nullptr;      // Optional cache of query results
+    TraceRecorder *trace = nullptr;   // Optional recorder of search events
 
     // Add an edge with a weight between two variables (for an undirected graph)
     void addEdge(const std::string &var1, const std::string &var2, int weight) {
         adjList[var1].push_back({var2, weight});
         adjList[var2].push_back({var1, weight});
+        version++;
+    }
+
+    // Change the weight of an existing edge (both directions). Returns false if there is no such edge.
+    bool setEdgeWeight(const std::string &var1, const std::string &var2, int weight) {
+        bool changed = false;
+        auto it1 = adjList.find(var1), it2 = adjList.find(var2);
+        if (it1 == adjList.end() || it2 == adjList.end()) return false;
+        for (auto &neighbor : it1->second) {
+            if (neighbor.first == var2) neighbor.second = weight, changed = true;
+        }
+        for (auto &neighbor : it2->second) {
+            if (neighbor.first == var1) neighbor.second = weight, changed = true;
+        }
+        if (changed) version++;
+        return changed;
     }
 
     // Display the graph in the terminal (ASCII representation)
@@ -55,8 +79,31 @@ public:
         return std::abs(static_cast<int>(node[0]) - static_cast<int>(goal[0]));
     }
 
-    // A* algorithm with heuristics and extended list
+    // A* search, printing the path found
     void aStar(const std::string &source, const std::string &destination) {
+        std::cout << "Starting A* Search from " << source << " to " << destination << "...\n";
+        auto result = aStarPath(source, destination);
+        if (!result->found) {
+            std::cout << "No path found from " << source << " to " << destination << ".\n";
+            return;
+        }
+        std::cout << "Path found with total cost " << result->cost << ": ";
+        for (const auto &node : result->path) {
+            std::cout << node << " -> ";
+        }
+        std::cout << "END" << std::endl;
+    }
+
+    // A* search, answered from the cache when one is attached and the graph has not changed since
+    std::shared_ptr<const PathResult> aStarPath(const std::string &source, const std::string &destination) {
+        if (!cache) return std::make_shared<const PathResult>(aStarSearch(source, destination));
+        uint64_t current = version.load();
+        return cache->getOrCompute(QueryCache::key("astar", "h=initial", source, destination), current,
+                                   [&] { return aStarSearch(source, destination); });
+    }
+
+    // A* algorithm with heuristics and extended list
+    PathResult aStarSearch(const std::string &source, const std::string &destination) {
         // Priority queue for open list: stores paths with f(n) = g(n) + h(n)
         std::priority_queue<std::tuple<double, int, std::vector<std::string>>,
                             std::vector<std::tuple<double, int, std::vector<std::string>>>,
@@ -67,35 +114,39 @@ public:
 
         // Start with the source node
         pq.push({0.0, 0, {source}});
-
-        std::cout << "Starting A* Search from " << source << " to " << destination << "...\n";
+        if (trace) trace->push(trace->intern(source), TRACE_NO_NODE, 0);
 
         while (!pq.empty()) {
             // Extract the current path and cost
             auto [fCost, gCost, path] = pq.top();
             pq.pop();
             std::string currentNode = path.back();
+            uint32_t traceId = trace ? trace->intern(currentNode) : TRACE_NO_NODE;
 
-            // If we reached the destination, print the path
+            // If we reached the destination, return the path (h is 0 there, so f = g)
             if (currentNode == destination) {
-                std::cout << "Path found with total cost " << fCost << ": ";
-                for (const auto &node : path) {
-                    std::cout << node << " -> ";
-                }
-                std::cout << "END" << std::endl;
-                return;
+                if (trace) trace->goal(traceId, traceParent(path), gCost);
+                PathResult result;
+                result.found = true;
+                result.cost = gCost;
+                result.path = std::move(path);
+                return result;
             }
 
             // Skip if this node has already been fully expanded
             if (extendedList.find(currentNode) != extendedList.end()) {
+                if (trace) trace->prune(traceId, traceParent(path), gCost);
                 continue;
             }
 
             // Mark the node as fully expanded (added to extended list)
             extendedList.insert(currentNode);
+            if (trace) trace->expand(traceId, traceParent(path), gCost);
 
-            // Explore the neighbors
-            for (const auto &neighbor : adjList[currentNode]) {
+            // Explore the neighbors (find, not operator[], so that searching never inserts nodes)
+            auto neighbors = adjList.find(currentNode);
+            if (neighbors == adjList.end()) continue;
+            for (const auto &neighbor : neighbors->second) {
                 if (extendedList.find(neighbor.first) == extendedList.end()) {
                     // Create a new path to this neighbor
                     std::vector<std::string> newPath = path;
@@ -108,16 +159,37 @@ public:
 
                     // Push the new path into the priority queue
                     pq.push({newFCost, newGCost, newPath});
+                    if (trace) trace->push(trace->intern(neighbor.first), traceId, newGCost);
                 }
             }
         }
 
-        std::cout << "No path found from " << source << " to " << destination << ".\n";
+        return PathResult();
+    }
+
+private:
+    // Trace id of the node a path came from (TRACE_NO_NODE for the source)
+    uint32_t traceParent(const std::vector<std::string> &path) {
+        return path.size() > 1 ? trace->intern(path[path.size() - 2]) : TRACE_NO_NODE;
     }
 };
 
 int main() {
     Graph graph;
+    QueryCache cache(4096);
+    graph.cache = &cache;
+
+    // Tracing is opt-in: SEARCH_TRACE=<file> records the search for the visualizer
+    std::unique_ptr<TraceRecorder> trace;
+    if (const char *tracePath = std::getenv("SEARCH_TRACE")) {
+        trace.reset(new TraceRecorder(tracePath));
+        if (trace->ok()) {
+            graph.trace = trace.get();
+        } else {
+            std::cout << "Cannot write trace file " << tracePath << "; tracing disabled." << std::endl;
+            trace.reset();
+        }
+    }
 
     // Define the relationships (edges between variables) with weights
     graph.addEdge("A", "B", 4);
@@ -157,6 +229,19 @@ int main() {
 
     // Perform A* Search from source to destination
     graph.aStar(source, destination);
+    if (trace) {
+        graph.trace = nullptr;
+        bool written = trace->close();
+        std::cout << (written ? "Trace written: " : "Trace incomplete: ") << trace->eventCount() << " events" << std::endl;
+    }
+
+    // Repeating the query is answered from the cache
+    auto start = std::chrono::steady_clock::now();
+    graph.aStarPath(source, destination);
+    double micros = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+    QueryCacheStats stats = cache.stats();
+    std::cout << "Repeated query took " << micros << " us (cache: " << stats.hits << " hits, "
+              << stats.misses << " misses)" << std::endl;
 
     return 0;
 }
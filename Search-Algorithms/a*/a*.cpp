@@ -8,6 +8,7 @@
 #include <cmath>    // For std::abs
 #include <cstdlib>  // For system()
 #include <limits>   // For std::numeric_limits
+#include "../dot_io/dot_io.h"
 
 class Graph {
 public:
@@ -33,20 +34,12 @@ public:
         std::cout << "----------------------------------\n";
     }
 
-    // Export the graph to a DOT file for Graphviz visualization
+    // Export the graph to a DOT file for Graphviz visualization (each undirected edge once)
     void exportGraphToDot(const std::string &filename) {
-        std::ofstream dotFile;
-        dotFile.open(filename);
-
-        dotFile << "graph G {\n";
-        for (const auto &node : adjList) {
-            for (const auto &neighbor : node.second) {
-                dotFile << "  " << node.first << " -- " << neighbor << ";\n";
-            }
+        if (writeUndirectedDot(adjList, filename) < 0) {
+            std::cout << "Could not write " << filename << "." << std::endl;
+            return;
         }
-        dotFile << "}\n";
-        dotFile.close();
-
         std::cout << "Graph exported to " << filename << " successfully." << std::endl;
     }
 
@@ -81,8 +74,10 @@ public:
                 return;
             }
 
-            // Mark the current node as visited
-            closedSet.insert(currentNode);
+            // Mark the current node as visited; a duplicate entry for an expanded node is skipped
+            if (!closedSet.insert(currentNode).second) {
+                continue;
+            }
 
             // Explore the neighbors
             for (const auto &neighbor : adjList[currentNode]) {
@@ -6,6 +6,8 @@
 #include <set>
 #include <algorithm>
 #include <cstdlib>  // For system()
+#include "../dot_io/dot_io.h"
+#include "../k_shortest/k_shortest.h"
 
 class Graph {
 public:
@@ -31,20 +33,12 @@ public:
         std::cout << "----------------------------------\n";
     }
 
-    // Export the graph to a DOT file for Graphviz visualization
+    // Export the graph to a DOT file for Graphviz visualization (each undirected edge once)
     void exportGraphToDot(const std::string &filename) {
-        std::ofstream dotFile;
-        dotFile.open(filename);
-
-        dotFile << "graph G {\n";
-        for (const auto &node : adjList) {
-            for (const auto &neighbor : node.second) {
-                dotFile << "  " << node.first << " -- " << neighbor << ";\n";
-            }
+        if (writeUndirectedDot(adjList, filename) < 0) {
+            std::cout << "Could not write " << filename << "." << std::endl;
+            return;
         }
-        dotFile << "}\n";
-        dotFile.close();
-
         std::cout << "Graph exported to " << filename << " successfully." << std::endl;
     }
 
@@ -91,6 +85,29 @@ public:
             std::cout << "No path found from " << source << " to " << destination << "." << std::endl;
         }
     }
+
+    // Print only the k shortest paths (fewest edges first), without enumerating the rest
+    void printShortestPaths(const std::string &source, const std::string &destination, size_t k) {
+        KspGraph graph;
+        for (const auto &node : adjList) {
+            for (const auto &neighbor : node.second) {
+                graph.addEdge(node.first, neighbor, 1);
+            }
+        }
+        int from = graph.find(source), to = graph.find(destination);
+        if (from < 0 || to < 0) return;
+
+        std::cout << "The " << k << " shortest paths from " << source << " to " << destination << ":\n";
+        YenKShortestPaths paths(graph, from, to);
+        KPath path;
+        for (size_t i = 0; i < k && paths.next(path); i++) {
+            std::cout << "Path (" << path.cost << " edges): ";
+            for (int node : path.nodes) {
+                std::cout << graph.name(node) << " -> ";
+            }
+            std::cout << "END" << std::endl;
+        }
+    }
 };
 
 int main() {
@@ -132,5 +149,8 @@ int main() {
     // Perform lexicographical BFS from source to destination
     graph.bfsLexicographical(source, destination);
 
+    // When only the best few are needed, k-shortest-paths avoids enumerating every path
+    graph.printShortestPaths(source, destination, 3);
+
     return 0;
 }
@@ -4,17 +4,113 @@
 #include <vector>
 #include <set>
 #include <queue>
+#include <string>
+#include <utility>
+#include <algorithm>
 #include <limits>
 #include <cstdlib>  // For system()
 
+// Largest edge weight for which the Dial bucket queue is used; above this the radix heap is used
+const int DIAL_MAX_WEIGHT = 1024;
+
+// Dial bucket queue: a circular array of (maxWeight + 1) buckets indexed by cost.
+// Valid because every key pushed lies in [lastPopped, lastPopped + maxWeight].
+template <typename T>
+class DialQueue {
+public:
+    explicit DialQueue(int maxWeight) : buckets(maxWeight + 1), current(0), count(0) {}
+
+    void push(int key, T value) {
+        buckets[key % buckets.size()].push_back({key, std::move(value)});
+        count++;
+    }
+
+    // Remove and return the entry with the smallest key (queue must not be empty)
+    std::pair<int, T> pop() {
+        while (buckets[current % buckets.size()].empty()) {
+            current++;
+        }
+        auto &bucket = buckets[current % buckets.size()];
+        std::pair<int, T> top = std::move(bucket.back());
+        bucket.pop_back();
+        count--;
+        return top;
+    }
+
+    bool empty() const { return count == 0; }
+
+private:
+    std::vector<std::vector<std::pair<int, T>>> buckets;
+    size_t current; // Cost of the bucket currently being drained
+    size_t count;
+};
+
+// Radix heap for non-negative integer keys: bucket i holds keys whose highest bit
+// differing from the last popped key is bit (i - 1). Each entry moves down at most 32 times.
+template <typename T>
+class RadixHeap {
+public:
+    RadixHeap() : buckets(33), last(0), count(0) {}
+
+    void push(int key, T value) {
+        unsigned k = static_cast<unsigned>(key);
+        buckets[bucketIndex(k)].push_back({k, std::move(value)});
+        count++;
+    }
+
+    // Remove and return the entry with the smallest key (queue must not be empty)
+    std::pair<int, T> pop() {
+        if (buckets[0].empty()) {
+            // Find the first non-empty bucket and redistribute it around its minimum key
+            size_t i = 1;
+            while (buckets[i].empty()) {
+                i++;
+            }
+            unsigned newLast = buckets[i][0].first;
+            for (const auto &entry : buckets[i]) {
+                newLast = std::min(newLast, entry.first);
+            }
+            last = newLast;
+            std::vector<std::pair<unsigned, T>> moving;
+            moving.swap(buckets[i]);
+            for (auto &entry : moving) {
+                buckets[bucketIndex(entry.first)].push_back(std::move(entry));
+            }
+        }
+        std::pair<unsigned, T> top = std::move(buckets[0].back());
+        buckets[0].pop_back();
+        count--;
+        return {static_cast<int>(top.first), std::move(top.second)};
+    }
+
+    bool empty() const { return count == 0; }
+
+private:
+    std::vector<std::vector<std::pair<unsigned, T>>> buckets;
+    unsigned last; // Last popped key; every stored key is >= last
+    size_t count;
+
+    size_t bucketIndex(unsigned key) const {
+        unsigned diff = key ^ last;
+        size_t bits = 0;
+        while (diff) {
+            bits++;
+            diff >>= 1;
+        }
+        return bits;
+    }
+};
+
 class Graph {
 public:
     std::unordered_map<std::string, std::vector<std::pair<std::string, int>>> adjList;
+    int maxEdgeWeight = 0; // Largest weight seen so far, used to pick the open list
 
     // Add an edge with a weight between two variables (for an undirected graph)
     void addEdge(const std::string &var1, const std::string &var2, int weight) {
         adjList[var1].push_back({var2, weight});
         adjList[var2].push_back({var1, weight});
+        maxEdgeWeight = std::max(maxEdgeWeight, weight);
     }
 
     // Display the graph in the terminal (ASCII representation)
@@ -50,24 +146,33 @@ public:
         std::cout << "Graph exported to " << filename << " successfully." << std::endl;
     }
 
-    // Branch and Bound algorithm with extended list to find the shortest path
+    // Branch and Bound algorithm with extended list to find the shortest path.
+    // Edge weights are non-negative integers, so the open list is a monotone integer queue:
+    // a Dial bucket queue for small weights, a radix heap otherwise.
     void branchAndBoundExtended(const std::string &source, const std::string &destination) {
-        // Min-heap to store paths and their associated costs
-        std::priority_queue<std::pair<int, std::vector<std::string>>, std::vector<std::pair<int, std::vector<std::string>>>, std::greater<>> pq;
-        
+        if (maxEdgeWeight <= DIAL_MAX_WEIGHT) {
+            DialQueue<std::vector<std::string>> pq(maxEdgeWeight);
+            branchAndBoundExtended(source, destination, pq);
+        } else {
+            RadixHeap<std::vector<std::string>> pq;
+            branchAndBoundExtended(source, destination, pq);
+        }
+    }
+
+    template <typename Queue>
+    void branchAndBoundExtended(const std::string &source, const std::string &destination, Queue &pq) {
         // Set to keep track of nodes that have been fully expanded
         std::set<std::string> extendedList;
         
         // Initialize with the source node
-        pq.push({0, {source}});
+        pq.push(0, {source});
 
         std::cout << "Starting Branch and Bound Search from " << source << " to " << destination << "...\n";
 
         while (!pq.empty()) {
-            auto current = pq.top();
-            pq.pop();
+            auto current = pq.pop();
             int currentCost = current.first;
-            std::vector<std::string> path = current.second;
+            std::vector<std::string> path = std::move(current.second);
             std::string currentNode = path.back();
 
             // If we reach the destination, print the path and terminate
@@ -96,8 +201,8 @@ public:
                     newPath.push_back(neighbor.first);
                     int newCost = currentCost + neighbor.second;
 
-                    // Push the new path into the priority queue
-                    pq.push({newCost, newPath});
+                    // Push the new path into the open list
+                    pq.push(newCost, std::move(newPath));
                 }
             }
         }
@@ -4,17 +4,145 @@
 #include <vector>
 #include <set>
 #include <queue>
+#include <string>
+#include <utility>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <memory>
 #include <cstdlib>  // For system()
 #include <limits>   // For std::numeric_limits
+#include "../query_cache/query_cache.h"
+#include "../search_trace/search_trace.h"
+
+// Largest edge weight for which the Dial bucket queue is used; above this the radix heap is used
+const int DIAL_MAX_WEIGHT = 1024;
+
+// Dial bucket queue: a circular array of (maxWeight + 1) buckets indexed by cost.
+// Valid because every key pushed lies in [lastPopped, lastPopped + maxWeight].
+template <typename T>
+class DialQueue {
+public:
+    explicit DialQueue(int maxWeight) : buckets(maxWeight + 1), current(0), count(0) {}
+
+    void push(int key, T value) {
+        buckets[key % buckets.size()].push_back({key, std::move(value)});
+        count++;
+    }
+
+    // Remove and return the entry with the smallest key (queue must not be empty)
+    std::pair<int, T> pop() {
+        while (buckets[current % buckets.size()].empty()) {
+            current++;
+        }
+        auto &bucket = buckets[current % buckets.size()];
+        std::pair<int, T> top = std::move(bucket.back());
+        bucket.pop_back();
+        count--;
+        return top;
+    }
+
+    bool empty() const { return count == 0; }
+
+private:
+    std::vector<std::vector<std::pair<int, T>>> buckets;
+    size_t current; // Cost of the bucket currently being drained
+    size_t count;
+};
+
+// Radix heap for non-negative integer keys: bucket i holds keys whose highest bit
+// differing from the last popped key is bit (i - 1). Each entry moves down at most 32 times.
+template <typename T>
+class RadixHeap {
+public:
+    RadixHeap() : buckets(33), last(0), count(0) {}
+
+    void push(int key, T value) {
+        unsigned k = static_cast<unsigned>(key);
+        buckets[bucketIndex(k)].push_back({k, std::move(value)});
+        count++;
+    }
+
+    // Remove and return the entry with the smallest key (queue must not be empty)
+    std::pair<int, T> pop() {
+        if (buckets[0].empty()) {
+            // Find the first non-empty bucket and redistribute it around its minimum key
+            size_t i = 1;
+            while (buckets[i].empty()) {
+                i++;
+            }
+            unsigned newLast = buckets[i][0].first;
+            for (const auto &entry : buckets[i]) {
+                newLast = std::min(newLast, entry.first);
+            }
+            last = newLast;
+            std::vector<std::pair<unsigned, T>> moving;
+            moving.swap(buckets[i]);
+            for (auto &entry : moving) {
+                buckets[bucketIndex(entry.first)].push_back(std::move(entry));
+            }
+        }
+        std::pair<unsigned, T> top = std::move(buckets[0].back());
+        buckets[0].pop_back();
+        count--;
+        return {static_cast<int>(top.first), std::move(top.second)};
+    }
+
+    bool empty() const { return count == 0; }
+
+private:
+    std::vector<std::vector<std::pair<unsigned, T>>> buckets;
+    unsigned last; // Last popped key; every stored key is >= last
+    size_t count;
+
+    size_t bucketIndex(unsigned key) const {
+        unsigned diff = key ^ last;
+        size_t bits = 0;
+        while (diff) {
+            bits++;
+            diff >>= 1;
+        }
+        return bits;
+    }
+};
 
 class Graph {
 public:
     std::unordered_map<std::string, std::vector<std::pair<std::string, int>>> adjList;
+    int maxEdgeWeight = 0; // Largest weight seen so far, used to pick the open list
+    std::atomic<uint64_t> version{0}; // Bumped by every change to the graph, so cached results go stale
+    QueryCache *cache = nullptr;      // Optional cache of query results
+    TraceRecorder *trace = nullptr;   // Optional recorder of search events
 
-    // Add an edge with a weight between two variables (for an undirected graph)
-    void addEdge(const std::string &var1, const std::string &var2, int weight) {
+    // Add an edge with a weight between two variables (for an undirected graph). Returns false,
+    // adding nothing, for a negative weight: the open lists need non-negative integer costs.
+    bool addEdge(const std::string &var1, const std::string &var2, int weight) {
+        if (weight < 0) return false;
         adjList[var1].push_back({var2, weight});
         adjList[var2].push_back({var1, weight});
+        maxEdgeWeight = std::max(maxEdgeWeight, weight);
+        version++;
+        return true;
+    }
+
+    // Change the weight of an existing edge (both directions). Returns false if there is no such
+    // edge or the weight is negative.
+    bool setEdgeWeight(const std::string &var1, const std::string &var2, int weight) {
+        if (weight < 0) return false;
+        bool changed = false;
+        auto it1 = adjList.find(var1), it2 = adjList.find(var2);
+        if (it1 == adjList.end() || it2 == adjList.end()) return false;
+        for (auto &neighbor : it1->second) {
+            if (neighbor.first == var2) neighbor.second = weight, changed = true;
+        }
+        for (auto &neighbor : it2->second) {
+            if (neighbor.first == var1) neighbor.second = weight, changed = true;
+        }
+        if (changed) {
+            maxEdgeWeight = std::max(maxEdgeWeight, weight);
+            version++;
+        }
+        return changed;
     }
 
     // Display the graph in the terminal (ASCII representation)
@@ -50,59 +178,119 @@ public:
         std::cout << "Graph exported to " << filename << " successfully." << std::endl;
     }
 
-    // Branch and Bound algorithm to find the shortest path
+    // Branch and Bound search, printing the path found
     void branchAndBound(const std::string &source, const std::string &destination) {
-        std::priority_queue<std::pair<int, std::vector<std::string>>, std::vector<std::pair<int, std::vector<std::string>>>, std::greater<>> pq;
-        std::set<std::string> visited;
-        pq.push({0, {source}});
-
         std::cout << "Starting Branch and Bound Search from " << source << " to " << destination << "...\n";
+        auto result = branchAndBoundPath(source, destination);
+        if (!result->found) {
+            std::cout << "No path found from " << source << " to " << destination << ".\n";
+            return;
+        }
+        std::cout << "Path found with cost " << result->cost << ": ";
+        for (const auto &node : result->path) {
+            std::cout << node << " -> ";
+        }
+        std::cout << "END" << std::endl;
+    }
+
+    // Branch and Bound search, answered from the cache when one is attached and the graph has not
+    // changed since. The open list does not change the cost found, so it is not part of the key.
+    std::shared_ptr<const PathResult> branchAndBoundPath(const std::string &source, const std::string &destination) {
+        if (!cache) return std::make_shared<const PathResult>(branchAndBoundSearch(source, destination));
+        uint64_t current = version.load();
+        return cache->getOrCompute(QueryCache::key("bnb", "", source, destination), current,
+                                   [&] { return branchAndBoundSearch(source, destination); });
+    }
+
+    // Branch and Bound algorithm to find the shortest path.
+    // Edge weights are non-negative integers, so the open list is a monotone integer queue:
+    // a Dial bucket queue for small weights, a radix heap otherwise.
+    PathResult branchAndBoundSearch(const std::string &source, const std::string &destination) {
+        if (maxEdgeWeight <= DIAL_MAX_WEIGHT) {
+            DialQueue<std::vector<std::string>> pq(maxEdgeWeight);
+            return branchAndBoundSearch(source, destination, pq);
+        } else {
+            RadixHeap<std::vector<std::string>> pq;
+            return branchAndBoundSearch(source, destination, pq);
+        }
+    }
+
+    template <typename Queue>
+    PathResult branchAndBoundSearch(const std::string &source, const std::string &destination, Queue &pq) {
+        std::set<std::string> visited;
+        pq.push(0, {source});
+        if (trace) trace->push(trace->intern(source), TRACE_NO_NODE, 0);
 
         while (!pq.empty()) {
-            auto current = pq.top();
-            pq.pop();
+            auto current = pq.pop();
             int currentCost = current.first;
-            std::vector<std::string> path = current.second;
+            std::vector<std::string> path = std::move(current.second);
             std::string currentNode = path.back();
+            uint32_t traceId = trace ? trace->intern(currentNode) : TRACE_NO_NODE;
 
-            // If we reach the destination, print the path and terminate
+            // If we reach the destination, return the path
             if (currentNode == destination) {
-                std::cout << "Path found with cost " << currentCost << ": ";
-                for (const auto &node : path) {
-                    std::cout << node << " -> ";
-                }
-                std::cout << "END" << std::endl;
-                return;
+                if (trace) trace->goal(traceId, traceParent(path), currentCost);
+                PathResult result;
+                result.found = true;
+                result.cost = currentCost;
+                result.path = std::move(path);
+                return result;
             }
 
             // Skip already visited nodes
             if (visited.find(currentNode) != visited.end()) {
+                if (trace) trace->prune(traceId, traceParent(path), currentCost);
                 continue;
             }
 
             // Mark the current node as visited
             visited.insert(currentNode);
+            if (trace) trace->expand(traceId, traceParent(path), currentCost);
 
-            // Explore the neighbors
-            for (const auto &neighbor : adjList[currentNode]) {
+            // Explore the neighbors (find, not operator[], so that searching never inserts nodes)
+            auto neighbors = adjList.find(currentNode);
+            if (neighbors == adjList.end()) continue;
+            for (const auto &neighbor : neighbors->second) {
                 if (visited.find(neighbor.first) == visited.end()) {
                     // Create a new path including the neighbor
                     std::vector<std::string> newPath = path;
                     newPath.push_back(neighbor.first);
                     int newCost = currentCost + neighbor.second;
 
-                    // Push the new path into the priority queue
-                    pq.push({newCost, newPath});
+                    // Push the new path into the open list
+                    pq.push(newCost, std::move(newPath));
+                    if (trace) trace->push(trace->intern(neighbor.first), traceId, newCost);
                 }
             }
         }
 
-        std::cout << "No path found from " << source << " to " << destination << ".\n";
+        return PathResult();
+    }
+
+private:
+    // Trace id of the node a path came from (TRACE_NO_NODE for the source)
+    uint32_t traceParent(const std::vector<std::string> &path) {
+        return path.size() > 1 ? trace->intern(path[path.size() - 2]) : TRACE_NO_NODE;
     }
 };
 
 int main() {
     Graph graph;
+    QueryCache cache(4096);
+    graph.cache = &cache;
+
+    // Tracing is opt-in: SEARCH_TRACE=<file> records the search for the visualizer
+    std::unique_ptr<TraceRecorder> trace;
+    if (const char *tracePath = std::getenv("SEARCH_TRACE")) {
+        trace.reset(new TraceRecorder(tracePath));
+        if (trace->ok()) {
+            graph.trace = trace.get();
+        } else {
+            std::cout << "Cannot write trace file " << tracePath << "; tracing disabled." << std::endl;
+            trace.reset();
+        }
+    }
 
     // Define the relationships (edges between variables) with weights
     graph.addEdge("x", "y", 4);
@@ -140,6 +328,19 @@ int main() {
 
     // Perform Branch and Bound Search from source to destination
     graph.branchAndBound(source, destination);
+    if (trace) {
+        graph.trace = nullptr;
+        bool written = trace->close();
+        std::cout << (written ? "Trace written: " : "Trace incomplete: ") << trace->eventCount() << " events" << std::endl;
+    }
+
+    // Repeating the query is answered from the cache
+    auto start = std::chrono::steady_clock::now();
+    graph.branchAndBoundPath(source, destination);
+    double micros = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+    QueryCacheStats stats = cache.stats();
+    std::cout << "Repeated query took " << micros << " us (cache: " << stats.hits << " hits, "
+              << stats.misses << " misses)" << std::endl;
 
     return 0;
 }
@@ -0,0 +1,277 @@
+#include <iostream>
+#include <fstream>
+#include <unordered_map>
+#include <vector>
+#include <string>
+#include <atomic>
+#include <thread>
+#include <algorithm>
+#include <functional>
+#include <cstdlib>  // For system()
+#include <limits>   // For std::numeric_limits
+
+// Result of a single-source shortest path computation
+struct ShortestPathTree {
+    std::vector<std::string> nodes;   // Node names, indexed by node id
+    std::vector<long long> distance;  // Distance from the source (INF if unreachable)
+    std::vector<int> parent;          // Parent node id in the tree (-1 for the source / unreachable)
+};
+
+const long long INF = std::numeric_limits<long long>::max();
+
+// Run fn(begin, end) over [0, n) split across numThreads threads.
+// Small ranges are run on the calling thread, where spawning would cost more than it saves.
+void parallelFor(size_t n, int numThreads, const std::function<void(size_t, size_t, int)> &fn) {
+    const size_t minPerThread = 2048;
+    size_t threads = std::min<size_t>(numThreads, (n + minPerThread - 1) / minPerThread);
+    if (threads <= 1) {
+        fn(0, n, 0);
+        return;
+    }
+    std::vector<std::thread> workers;
+    size_t chunk = (n + threads - 1) / threads;
+    for (size_t t = 0; t < threads; t++) {
+        size_t begin = t * chunk;
+        size_t end = std::min(n, begin + chunk);
+        workers.emplace_back(fn, begin, end, static_cast<int>(t));
+    }
+    for (auto &worker : workers) {
+        worker.join();
+    }
+}
+
+class Graph {
+public:
+    std::unordered_map<std::string, std::vector<std::pair<std::string, int>>> adjList;
+
+    // Add an edge with a weight between two variables (for an undirected graph)
+    void addEdge(const std::string &var1, const std::string &var2, int weight) {
+        adjList[var1].push_back({var2, weight});
+        adjList[var2].push_back({var1, weight});
+    }
+
+    // Export the graph to a DOT file for Graphviz visualization
+    void exportGraphToDot(const std::string &filename) {
+        std::ofstream dotFile;
+        dotFile.open(filename);
+
+        dotFile << "graph G {\n";
+        for (const auto &node : adjList) {
+            for (const auto &neighbor : node.second) {
+                if (node.first < neighbor.first) { // Avoid double printing edges in undirected graph
+                    dotFile << "  " << node.first << " -- " << neighbor.first << " [label=\"" << neighbor.second << "\"];\n";
+                }
+            }
+        }
+        dotFile << "}\n";
+        dotFile.close();
+
+        std::cout << "Graph exported to " << filename << " successfully." << std::endl;
+    }
+
+    // Delta-stepping single-source shortest paths.
+    // Nodes are kept in buckets of width delta. Each bucket is settled by repeatedly relaxing
+    // light edges (weight <= delta) of its nodes in parallel; heavy edges are relaxed once
+    // when the bucket is empty. delta <= 0 picks a default from the edge weights.
+    ShortestPathTree deltaStepping(const std::string &source, long long delta, int numThreads) {
+        ShortestPathTree tree;
+
+        // Flatten the string-keyed adjacency list into a compressed (CSR) layout
+        std::unordered_map<std::string, int> ids;
+        for (const auto &node : adjList) {
+            ids[node.first] = static_cast<int>(tree.nodes.size());
+            tree.nodes.push_back(node.first);
+        }
+        size_t n = tree.nodes.size();
+        std::vector<size_t> offsets(n + 1, 0);
+        std::vector<int> targets;
+        std::vector<int> weights;
+        long long maxWeight = 1;
+        for (size_t u = 0; u < n; u++) {
+            for (const auto &neighbor : adjList[tree.nodes[u]]) {
+                targets.push_back(ids[neighbor.first]);
+                weights.push_back(neighbor.second);
+                maxWeight = std::max<long long>(maxWeight, neighbor.second);
+            }
+            offsets[u + 1] = targets.size();
+        }
+
+        tree.distance.assign(n, INF);
+        tree.parent.assign(n, -1);
+        if (ids.find(source) == ids.end()) {
+            return tree;
+        }
+
+        if (delta <= 0) {
+            // Heuristic default: max weight divided by average degree
+            size_t avgDegree = n ? std::max<size_t>(1, targets.size() / n) : 1;
+            delta = std::max<long long>(1, maxWeight / static_cast<long long>(avgDegree));
+        }
+        numThreads = std::max(1, numThreads);
+
+        std::vector<std::atomic<long long>> dist(n);
+        for (auto &d : dist) {
+            d.store(INF, std::memory_order_relaxed);
+        }
+
+        // Every relaxation from bucket i lands in [i, i + maxWeight / delta + 1], so a cyclic array suffices
+        size_t numBuckets = static_cast<size_t>(maxWeight / delta) + 2;
+        std::vector<std::vector<int>> buckets(numBuckets);
+        size_t pending = 0; // Entries across all buckets (may include stale ones)
+
+        int src = ids[source];
+        dist[src].store(0);
+        buckets[0].push_back(src);
+        pending = 1;
+
+        // Per-thread lists of nodes whose distance improved
+        std::vector<std::vector<int>> improved(numThreads);
+
+        // Relax the light or heavy edges of every node in the frontier
+        auto relax = [&](const std::vector<int> &frontier, bool light) {
+            parallelFor(frontier.size(), numThreads, [&](size_t begin, size_t end, int t) {
+                for (size_t i = begin; i < end; i++) {
+                    int u = frontier[i];
+                    long long du = dist[u].load(std::memory_order_relaxed);
+                    for (size_t e = offsets[u]; e < offsets[u + 1]; e++) {
+                        if ((weights[e] <= delta) != light) {
+                            continue;
+                        }
+                        int v = targets[e];
+                        long long candidate = du + weights[e];
+                        long long current = dist[v].load(std::memory_order_relaxed);
+                        // Atomic min: retry until we win or someone else found a shorter distance
+                        while (candidate < current) {
+                            if (dist[v].compare_exchange_weak(current, candidate, std::memory_order_relaxed)) {
+                                improved[t].push_back(v);
+                                break;
+                            }
+                        }
+                    }
+                }
+            });
+            // Move improved nodes into their new buckets
+            for (auto &list : improved) {
+                for (int v : list) {
+                    long long d = dist[v].load(std::memory_order_relaxed);
+                    buckets[static_cast<size_t>(d / delta) % numBuckets].push_back(v);
+                    pending++;
+                }
+                list.clear();
+            }
+        };
+
+        long long currentBucket = 0;
+        while (pending > 0) {
+            // Find the next non-empty bucket
+            while (buckets[static_cast<size_t>(currentBucket) % numBuckets].empty()) {
+                currentBucket++;
+            }
+
+            std::vector<int> settled;
+            auto &bucket = buckets[static_cast<size_t>(currentBucket) % numBuckets];
+            while (!bucket.empty()) {
+                // Take the bucket, dropping stale entries whose distance moved to an earlier bucket
+                std::vector<int> frontier;
+                pending -= bucket.size();
+                for (int u : bucket) {
+                    if (dist[u].load(std::memory_order_relaxed) / delta == currentBucket) {
+                        frontier.push_back(u);
+                    }
+                }
+                bucket.clear();
+                std::sort(frontier.begin(), frontier.end());
+                frontier.erase(std::unique(frontier.begin(), frontier.end()), frontier.end());
+
+                // Light edges may refill the current bucket, so loop until it stays empty
+                relax(frontier, true);
+                settled.insert(settled.end(), frontier.begin(), frontier.end());
+            }
+
+            // Heavy edges always land in later buckets, so relax them once per bucket
+            std::sort(settled.begin(), settled.end());
+            settled.erase(std::unique(settled.begin(), settled.end()), settled.end());
+            relax(settled, false);
+            currentBucket++;
+        }
+
+        // Recover parents in a separate pass, so they always agree with the final distances: a
+        // breadth-first search from the source over the edges on shortest paths. Each node takes
+        // its parent from a node reached before it, so zero-weight edges cannot make parent cycles.
+        for (size_t v = 0; v < n; v++) {
+            tree.distance[v] = dist[v].load(std::memory_order_relaxed);
+        }
+        std::vector<char> reached(n, 0);
+        std::vector<int> queue = {src};
+        reached[src] = 1;
+        for (size_t head = 0; head < queue.size(); head++) {
+            int u = queue[head];
+            for (size_t e = offsets[u]; e < offsets[u + 1]; e++) {
+                int v = targets[e];
+                if (!reached[v] && tree.distance[u] + weights[e] == tree.distance[v]) {
+                    reached[v] = 1;
+                    tree.parent[v] = u;
+                    queue.push_back(v);
+                }
+            }
+        }
+
+        return tree;
+    }
+};
+
+int main() {
+    Graph graph;
+
+    // Define the relationships (edges between variables) with weights
+    graph.addEdge("x", "y", 4);
+    graph.addEdge("y", "z", 6);
+    graph.addEdge("x", "a", 2);
+    graph.addEdge("a", "b", 5);
+    graph.addEdge("b", "z", 3);
+    graph.addEdge("a", "y", 1);
+
+    // Export the graph to a DOT file for Graphviz visualization
+    std::string dotFilename = "graph_output.dot";
+    graph.exportGraphToDot(dotFilename);
+
+    // Use Graphviz to generate a PNG image of the graph
+    std::string graphImage = "graph_output.png";
+    std::string dotCommand = "dot -Tpng " + dotFilename + " -o " + graphImage;
+    system(dotCommand.c_str());  // Execute the dot command to generate the PNG image
+
+    // Open the PNG image using the default image viewer
+    #if defined(_WIN32) || defined(_WIN64)
+        system(("start " + graphImage).c_str()); // Windows
+    #elif defined(__APPLE__)
+        system(("open " + graphImage).c_str());  // macOS
+    #else
+        system(("xdg-open " + graphImage).c_str());  // Linux
+    #endif
+
+    // Now ask the user for the source, delta and thread count
+    std::string source;
+    long long delta = 0;
+    int numThreads = static_cast<int>(std::thread::hardware_concurrency());
+
+    std::cout << "Enter the source variable: ";
+    std::getline(std::cin, source);
+    std::cout << "Enter delta (0 for automatic): ";
+    std::cin >> delta;
+
+    // Compute the full shortest path tree from the source
+    ShortestPathTree tree = graph.deltaStepping(source, delta, numThreads);
+
+    std::cout << "Shortest distances from " << source << ":\n";
+    for (size_t v = 0; v < tree.nodes.size(); v++) {
+        std::cout << "  " << tree.nodes[v] << ": ";
+        if (tree.distance[v] == INF) {
+            std::cout << "unreachable\n";
+            continue;
+        }
+        std::cout << tree.distance[v] << " (parent: "
+                  << (tree.parent[v] >= 0 ? tree.nodes[tree.parent[v]] : "-") << ")\n";
+    }
+
+    return 0;
+}
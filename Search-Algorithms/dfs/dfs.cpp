@@ -5,6 +5,7 @@
 #include <set>
 #include <algorithm>
 #include <cstdlib>  // For system()
+#include "../dot_io/dot_io.h"
 
 class Graph {
 public:
@@ -30,20 +31,12 @@ public:
         std::cout << "----------------------------------\n";
     }
 
-    // Export the graph to a DOT file for Graphviz visualization
+    // Export the graph to a DOT file for Graphviz visualization (each undirected edge once)
     void exportGraphToDot(const std::string &filename) {
-        std::ofstream dotFile;
-        dotFile.open(filename);
-
-        dotFile << "graph G {\n";
-        for (const auto &node : adjList) {
-            for (const auto &neighbor : node.second) {
-                dotFile << "  " << node.first << " -- " << neighbor << ";\n";
-            }
+        if (writeUndirectedDot(adjList, filename) < 0) {
+            std::cout << "Could not write " << filename << "." << std::endl;
+            return;
         }
-        dotFile << "}\n";
-        dotFile.close();
-
         std::cout << "Graph exported to " << filename << " successfully." << std::endl;
     }
 
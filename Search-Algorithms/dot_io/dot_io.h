@@ -0,0 +1,746 @@
+#ifndef DOT_IO_H
+#define DOT_IO_H
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cctype>
+#include <cerrno>
+#include <string>
+#include <vector>
+#include <queue>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+
+// Graphviz DOT input and output for the adjacency-list graphs in this repository.
+//
+// DotWriter writes through one large buffer of its own (the FILE is unbuffered), quoting names
+// that are not plain DOT identifiers. writeUndirectedDot() writes each undirected edge once and
+// can restrict the output to the subgraph induced by a set of nodes, such as kHopNeighborhood()
+// of a search result (writeNeighborhoodDot()). DotReader parses DOT in a single pass over
+// fixed-size chunks of the file, handing every edge to a callback, so its memory use does not grow
+// with the file; readUndirectedDot() uses it to load a file into an adjacency list.
+
+// Neighbour entries are either a name (unweighted graphs) or a (name, weight) pair
+inline const std::string &dotNeighborName(const std::string &neighbor) {
+    return neighbor;
+}
+
+inline const std::string &dotNeighborName(const std::pair<std::string, int> &neighbor) {
+    return neighbor.first;
+}
+
+inline bool dotNeighborWeight(const std::string &, int &) {
+    return false;
+}
+
+inline bool dotNeighborWeight(const std::pair<std::string, int> &neighbor, int &weight) {
+    weight = neighbor.second;
+    return true;
+}
+
+inline void dotAddNeighbor(std::vector<std::string> &neighbors, const std::string &name, int) {
+    neighbors.push_back(name);
+}
+
+inline void dotAddNeighbor(std::vector<std::pair<std::string, int>> &neighbors, const std::string &name, int weight) {
+    neighbors.push_back({name, weight});
+}
+
+class DotWriter {
+public:
+    explicit DotWriter(const std::string &filename, size_t bufferSize = 1 << 20)
+        : buffer(bufferSize < 4096 ? 4096 : bufferSize) {
+        file = std::fopen(filename.c_str(), "wb");
+        if (file) std::setvbuf(file, nullptr, _IONBF, 0); // Our buffer is the only one
+    }
+
+    ~DotWriter() {
+        close();
+    }
+
+    DotWriter(const DotWriter &) = delete;
+    DotWriter &operator=(const DotWriter &) = delete;
+
+    bool ok() const {
+        return file && !failed;
+    }
+
+    void begin(bool directed = false, const std::string &name = "G") {
+        this->directed = directed;
+        append(directed ? "digraph " : "graph ");
+        writeId(name);
+        append(" {\n");
+    }
+
+    void node(const std::string &name) {
+        append("  ");
+        writeId(name);
+        append(";\n");
+    }
+
+    void edge(const std::string &from, const std::string &to) {
+        edgeStart(from, to);
+        append(";\n");
+    }
+
+    void edge(const std::string &from, const std::string &to, int weight) {
+        edgeStart(from, to);
+        char label[32];
+        int length = std::snprintf(label, sizeof(label), " [label=\"%d\"];\n", weight);
+        append(label, length);
+    }
+
+    // Close the graph and the file. Returns false if anything failed to write.
+    bool close() {
+        if (!file) return false;
+        append("}\n");
+        flush();
+        if (std::fclose(file) != 0) failed = true;
+        file = nullptr;
+        return !failed;
+    }
+
+private:
+    FILE *file = nullptr;
+    std::vector<char> buffer;
+    size_t used = 0;
+    bool directed = false;
+    bool failed = false;
+
+    void edgeStart(const std::string &from, const std::string &to) {
+        append("  ");
+        writeId(from);
+        append(directed ? " -> " : " -- ");
+        writeId(to);
+    }
+
+    void flush() {
+        if (used && file && std::fwrite(buffer.data(), 1, used, file) != used) failed = true;
+        used = 0;
+    }
+
+    void append(const char *text, size_t length) {
+        if (used + length > buffer.size()) {
+            flush();
+            if (length > buffer.size()) {
+                if (file && std::fwrite(text, 1, length, file) != length) failed = true;
+                return;
+            }
+        }
+        std::memcpy(buffer.data() + used, text, length);
+        used += length;
+    }
+
+    void append(const char *text) {
+        append(text, std::strlen(text));
+    }
+
+    void append(const std::string &text) {
+        append(text.data(), text.size());
+    }
+
+    static bool plainId(const std::string &name) {
+        if (name.empty()) return false;
+        bool numeral = true;
+        bool alpha = !(name[0] >= '0' && name[0] <= '9');
+        for (unsigned char c : name) {
+            bool letter = c == '_' || c >= 128 || (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z');
+            bool digit = c >= '0' && c <= '9';
+            if (!letter && !digit) alpha = false;
+            if (!digit && c != '.' && c != '-') numeral = false;
+        }
+        if (alpha) {
+            // Keywords must be quoted to be used as names
+            static const char *keywords[] = {"node", "edge", "graph", "digraph", "subgraph", "strict"};
+            for (const char *keyword : keywords) {
+                if (name.size() == std::strlen(keyword)) {
+                    bool same = true;
+                    for (size_t i = 0; i < name.size(); i++) {
+                        same = same && std::tolower(static_cast<unsigned char>(name[i])) == keyword[i];
+                    }
+                    if (same) return false;
+                }
+            }
+            return true;
+        }
+        if (!numeral) return false;
+        // [-]?(.[0-9]+ | [0-9]+(.[0-9]*)?)
+        size_t i = name[0] == '-' ? 1 : 0;
+        size_t digits = 0, dots = 0;
+        for (; i < name.size(); i++) {
+            if (name[i] == '.') dots++;
+            else if (name[i] == '-') return false;
+            else digits++;
+        }
+        return digits > 0 && dots <= 1;
+    }
+
+    // Quoted names escape '"' and '\\' with a backslash, which is what DotReader undoes
+    void writeId(const std::string &name) {
+        if (plainId(name)) {
+            append(name);
+            return;
+        }
+        append("\"", 1);
+        size_t start = 0;
+        for (size_t i = 0; i < name.size(); i++) {
+            if (name[i] == '"' || name[i] == '\\') {
+                append(name.data() + start, i - start);
+                append("\\", 1);
+                start = i; // The character itself goes out with the next run
+            }
+        }
+        append(name.data() + start, name.size() - start);
+        append("\"", 1);
+    }
+};
+
+// Write an undirected adjacency-list graph (every edge stored in both endpoints' lists) with
+// each edge once. With `keep`, only the subgraph induced by those nodes is written. Returns the
+// number of edges written, or -1 if the file could not be written.
+template <typename AdjList>
+long long writeUndirectedDot(const AdjList &adjList, const std::string &filename,
+                             const std::unordered_set<std::string> *keep = nullptr, size_t bufferSize = 1 << 20) {
+    DotWriter writer(filename, bufferSize);
+    if (!writer.ok()) return -1;
+    writer.begin();
+    long long edges = 0;
+    for (const auto &node : adjList) {
+        if (keep && !keep->count(node.first)) continue;
+        bool connected = false;
+        size_t selfLoops = 0;
+        for (const auto &neighbor : node.second) {
+            const std::string &name = dotNeighborName(neighbor);
+            if (keep && !keep->count(name)) continue;
+            connected = true;
+            // The smaller endpoint writes the edge; a self-loop is stored twice in its own list
+            if (node.first < name || (node.first == name && selfLoops++ % 2 == 0)) {
+                int weight;
+                if (dotNeighborWeight(neighbor, weight)) writer.edge(node.first, name, weight);
+                else writer.edge(node.first, name);
+                edges++;
+            }
+        }
+        if (!connected) writer.node(node.first);
+    }
+    return writer.close() ? edges : -1;
+}
+
+// Nodes within `hops` edges of any seed (seeds included)
+template <typename AdjList>
+std::unordered_set<std::string> kHopNeighborhood(const AdjList &adjList, const std::vector<std::string> &seeds, int hops) {
+    std::unordered_set<std::string> reached;
+    std::queue<std::pair<std::string, int>> frontier;
+    for (const auto &seed : seeds) {
+        if (reached.insert(seed).second) frontier.push({seed, 0});
+    }
+    while (!frontier.empty()) {
+        auto [node, distance] = frontier.front();
+        frontier.pop();
+        auto it = adjList.find(node);
+        if (distance == hops || it == adjList.end()) continue;
+        for (const auto &neighbor : it->second) {
+            const std::string &name = dotNeighborName(neighbor);
+            if (reached.insert(name).second) frontier.push({name, distance + 1});
+        }
+    }
+    return reached;
+}
+
+// Write only the nodes within `hops` edges of `seeds` (for example a path found by a search).
+// Returns the number of edges written, or -1 if the file could not be written.
+template <typename AdjList>
+long long writeNeighborhoodDot(const AdjList &adjList, const std::vector<std::string> &seeds, int hops,
+                               const std::string &filename) {
+    std::unordered_set<std::string> keep = kHopNeighborhood(adjList, seeds, hops);
+    return writeUndirectedDot(adjList, filename, &keep);
+}
+
+// Single-pass DOT parser over a fixed-size read buffer.
+//
+// Supports graph/digraph/strict, node, edge and attribute statements, edge chains (a -- b -- c),
+// node groups as endpoints (a -- {b c}), subgraphs (flattened), ports, quoted strings with '+'
+// concatenation (\" and \\ stand for " and \, a backslash-newline is dropped), HTML strings and
+// C, C++ and '#' comments. An edge's weight is its numeric "weight" attribute, else its numeric
+// "label", else there is none. Only the current statement is held in memory.
+class DotReader {
+public:
+    bool directed = false;
+    std::string graphName;
+    std::string error;                 // Why read() returned false
+    unsigned long long edgeCount = 0;  // Edges reported
+    unsigned long long nodeCount = 0;  // Node statements reported
+
+    explicit DotReader(size_t bufferSize = 1 << 20) : buffer(bufferSize < 4096 ? 4096 : bufferSize) {}
+
+    // Parse `filename`, calling onEdge(from, to, weight, hasWeight) for every edge and
+    // onNode(name) for every node statement. Returns false (with `error`) on I/O or syntax errors.
+    template <typename OnEdge, typename OnNode>
+    bool read(const std::string &filename, OnEdge onEdge, OnNode onNode) {
+        file = std::fopen(filename.c_str(), "rb");
+        if (!file) {
+            error = filename + ": " + std::strerror(errno);
+            return false;
+        }
+        position = end = 0;
+        line = 1;
+        lineStart = true;
+        atEof = false;
+        pending.clear();
+        spaceError.clear();
+        error.clear();
+        edgeCount = nodeCount = 0;
+        bool ok = parse(onEdge, onNode);
+        std::fclose(file);
+        file = nullptr;
+        return ok;
+    }
+
+    template <typename OnEdge>
+    bool read(const std::string &filename, OnEdge onEdge) {
+        return read(filename, onEdge, [](const std::string &) {});
+    }
+
+    // Line being parsed; inside a callback, the line the statement ends on
+    unsigned long long lineNumber() const {
+        return line;
+    }
+
+private:
+    enum Kind { END, ID, LBRACE, RBRACE, LBRACKET, RBRACKET, SEMICOLON, COMMA, EQUAL, EDGEOP, COLON, BAD };
+
+    struct Token {
+        Kind kind;
+        std::string text;
+        bool quoted;
+    };
+
+    FILE *file = nullptr;
+    std::vector<char> buffer;
+    size_t position = 0, end = 0;
+    bool atEof = false;
+    unsigned long long line = 1;
+    bool lineStart = true;
+    std::vector<Token> pending; // Lookahead and pushed-back tokens, next one last
+    std::string spaceError;    // Set by skipSpace(), reported as the next token
+
+    // Characters
+
+    int peekChar() {
+        if (position == end) {
+            if (atEof) return -1;
+            end = std::fread(buffer.data(), 1, buffer.size(), file);
+            position = 0;
+            if (end == 0) {
+                atEof = true;
+                return -1;
+            }
+        }
+        return static_cast<unsigned char>(buffer[position]);
+    }
+
+    int getChar() {
+        int c = peekChar();
+        if (c < 0) return c;
+        position++;
+        if (c == '\n') {
+            line++;
+            lineStart = true;
+        } else if (c != ' ' && c != '\t' && c != '\r') {
+            lineStart = false;
+        }
+        return c;
+    }
+
+    // Skip whitespace and comments; false (with spaceError) on a bad comment
+    bool skipSpace() {
+        if (!spaceError.empty()) return false;
+        for (;;) {
+            int c = peekChar();
+            if (c == ' ' || c == '\t' || c == '\r' || c == '\f' || c == '\v') {
+                position++; // Blanks do not end the start of a line
+            } else if (c == '\n') {
+                getChar();
+            } else if (c == '#' && lineStart) {
+                while (c >= 0 && c != '\n') c = getChar();
+            } else if (c == '/') {
+                getChar();
+                int next = peekChar();
+                if (next == '/') {
+                    while (c >= 0 && c != '\n') c = getChar();
+                } else if (next == '*') {
+                    getChar();
+                    int previous = 0;
+                    for (;;) {
+                        c = getChar();
+                        if (c < 0) {
+                            spaceError = "unterminated comment";
+                            return false;
+                        }
+                        if (previous == '*' && c == '/') break;
+                        previous = c;
+                    }
+                } else {
+                    spaceError = "unexpected '/'";
+                    return false;
+                }
+            } else {
+                return true;
+            }
+        }
+    }
+
+    // Tokens
+
+    static bool idChar(int c) {
+        return c == '_' || c >= 128 || (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9');
+    }
+
+    bool readQuoted(std::string &text) {
+        getChar(); // Opening quote
+        for (;;) {
+            int c = getChar();
+            if (c < 0) return false;
+            if (c == '"') return true;
+            if (c == '\\') {
+                int next = peekChar();
+                if (next == '"' || next == '\\') {
+                    text.push_back(static_cast<char>(getChar()));
+                    continue;
+                }
+                if (next == '\n' || next == '\r') { // Line continuation
+                    if (getChar() == '\r' && peekChar() == '\n') getChar();
+                    continue;
+                }
+            }
+            text.push_back(static_cast<char>(c));
+        }
+    }
+
+    // Append characters to `text` while pred(c) holds, scanning the buffer directly
+    template <typename Pred>
+    void appendWhile(std::string &text, Pred pred) {
+        for (;;) {
+            if (peekChar() < 0) return;
+            size_t start = position;
+            while (position < end && pred(static_cast<unsigned char>(buffer[position]))) position++;
+            text.append(buffer.data() + start, position - start);
+            if (position > start) lineStart = false;
+            if (position < end) return;
+        }
+    }
+
+    Token nextToken() {
+        if (!pending.empty()) {
+            Token token = std::move(pending.back());
+            pending.pop_back();
+            return token;
+        }
+        return readToken();
+    }
+
+    const Token &peekToken() {
+        if (pending.empty()) pending.push_back(readToken());
+        return pending.back();
+    }
+
+    Token readToken() {
+        if (!skipSpace()) return {BAD, spaceError, false};
+        int c = peekChar();
+        if (c < 0) return {END, std::string(), false};
+        switch (c) {
+        case '{': getChar(); return {LBRACE, std::string(), false};
+        case '}': getChar(); return {RBRACE, std::string(), false};
+        case '[': getChar(); return {LBRACKET, std::string(), false};
+        case ']': getChar(); return {RBRACKET, std::string(), false};
+        case ';': getChar(); return {SEMICOLON, std::string(), false};
+        case ',': getChar(); return {COMMA, std::string(), false};
+        case '=': getChar(); return {EQUAL, std::string(), false};
+        case ':': getChar(); return {COLON, std::string(), false};
+        default: break;
+        }
+        Token token{ID, "", false};
+        if (c == '"') {
+            token.quoted = true;
+            for (;;) {
+                if (!readQuoted(token.text)) return {BAD, "unterminated string", false};
+                // "a" + "b" concatenates
+                if (!skipSpace() || peekChar() != '+') break;
+                getChar();
+                if (!skipSpace() || peekChar() != '"') return {BAD, "'+' must join two strings", false};
+            }
+            return token;
+        }
+        if (c == '<') {
+            getChar();
+            int depth = 1;
+            for (;;) {
+                c = getChar();
+                if (c < 0) return {BAD, "unterminated HTML string", false};
+                if (c == '<') depth++;
+                if (c == '>' && --depth == 0) break;
+                token.text.push_back(static_cast<char>(c));
+            }
+            token.quoted = true;
+            return token;
+        }
+        if (c == '-') {
+            getChar();
+            int next = peekChar();
+            if (next == '-' || next == '>') {
+                getChar();
+                return {EDGEOP, std::string(), false};
+            }
+            token.text.push_back('-');
+            c = next;
+        }
+        if (c == '.' || (c >= '0' && c <= '9')) {
+            appendWhile(token.text, [](int x) { return x == '.' || (x >= '0' && x <= '9'); });
+            return token;
+        }
+        if (idChar(c)) {
+            appendWhile(token.text, idChar);
+            return token;
+        }
+        return {BAD, std::string("unexpected character '") + static_cast<char>(c) + "'", false};
+    }
+
+    static bool isKeyword(const Token &token, const char *keyword) {
+        if (token.kind != ID || token.quoted || token.text.size() != std::strlen(keyword)) return false;
+        for (size_t i = 0; i < token.text.size(); i++) {
+            if (std::tolower(static_cast<unsigned char>(token.text[i])) != keyword[i]) return false;
+        }
+        return true;
+    }
+
+    bool fail(const std::string &message) {
+        error = "line " + std::to_string(line) + ": " + message;
+        return false;
+    }
+
+    bool unexpected(const Token &token) {
+        if (token.kind == BAD) return fail(token.text);
+        if (token.kind == END) return fail("unexpected end of file");
+        // Punctuation tokens carry no text, to keep tokenizing free of string construction
+        static const char *punctuation[] = {"", "", "{", "}", "[", "]", ";", ",", "=", "edge operator", ":"};
+        return fail("unexpected '" + (token.kind == ID ? token.text : std::string(punctuation[token.kind])) + "'");
+    }
+
+    // Parsing
+
+    static bool parseInt(const std::string &text, int &value) {
+        if (text.empty()) return false;
+        char *stop = nullptr;
+        errno = 0;
+        long parsed = std::strtol(text.c_str(), &stop, 10);
+        if (*stop != '\0' || errno == ERANGE || parsed < -2147483647L - 1 || parsed > 2147483647L) return false;
+        value = static_cast<int>(parsed);
+        return true;
+    }
+
+    // Zero or more [k=v, ...] lists; picks up the edge weight
+    bool parseAttributes(int &weight, bool &hasWeight) {
+        bool fromWeight = false;
+        while (peekToken().kind == LBRACKET) {
+            nextToken();
+            for (;;) {
+                Token key = nextToken();
+                if (key.kind == RBRACKET) break;
+                if (key.kind == SEMICOLON || key.kind == COMMA) continue;
+                if (key.kind != ID) return unexpected(key);
+                Token equal = nextToken();
+                if (equal.kind != EQUAL) return unexpected(equal);
+                Token value = nextToken();
+                if (value.kind != ID) return unexpected(value);
+                int parsed;
+                if (key.text == "weight" && parseInt(value.text, parsed)) {
+                    weight = parsed;
+                    hasWeight = fromWeight = true;
+                } else if (key.text == "label" && !fromWeight && parseInt(value.text, parsed)) {
+                    weight = parsed;
+                    hasWeight = true;
+                }
+            }
+        }
+        return true;
+    }
+
+    // Optional ":port[:compass]" after a node id
+    bool skipPort() {
+        for (int part = 0; part < 2 && peekToken().kind == COLON; part++) {
+            nextToken();
+            Token port = nextToken();
+            if (port.kind != ID) return unexpected(port);
+        }
+        return true;
+    }
+
+    // After '{': a group of node ids only, if that is all the braces hold. Otherwise the ids read
+    // so far are node statements of a subgraph body, and parsing carries on inside it.
+    // Returns 1 for a complete group, 0 for a subgraph body, -1 on error.
+    template <typename OnNode>
+    int parseGroup(std::vector<std::string> &group, OnNode &onNode) {
+        group.clear();
+        for (;;) {
+            Token token = nextToken();
+            if (token.kind == ID && !isKeyword(token, "subgraph") && !isKeyword(token, "node") &&
+                !isKeyword(token, "edge") && !isKeyword(token, "graph")) {
+                Kind after = peekToken().kind;
+                if (after == ID || after == SEMICOLON || after == COMMA || after == RBRACE) {
+                    group.push_back(std::move(token.text));
+                    continue;
+                }
+                pending.push_back(std::move(token)); // Start of a longer statement
+            } else if (token.kind == SEMICOLON || token.kind == COMMA) {
+                continue;
+            } else if (token.kind == RBRACE) {
+                return 1;
+            } else {
+                pending.push_back(std::move(token));
+            }
+            for (const auto &name : group) {
+                onNode(name);
+                nodeCount++;
+            }
+            group.clear();
+            return 0;
+        }
+    }
+
+    template <typename OnEdge, typename OnNode>
+    bool parse(OnEdge &onEdge, OnNode &onNode) {
+        Token token = nextToken();
+        if (isKeyword(token, "strict")) token = nextToken();
+        if (isKeyword(token, "digraph")) directed = true;
+        else if (isKeyword(token, "graph")) directed = false;
+        else return unexpected(token);
+        token = nextToken();
+        if (token.kind == ID) {
+            graphName = token.text;
+            token = nextToken();
+        }
+        if (token.kind != LBRACE) return unexpected(token);
+
+        int depth = 1;
+        // Endpoints of the current edge statement; the vectors are reused between statements
+        std::vector<std::vector<std::string>> chain;
+        size_t links = 0;
+        auto nextEndpoint = [&]() -> std::vector<std::string> & {
+            if (links == chain.size()) chain.emplace_back();
+            chain[links].clear();
+            return chain[links++];
+        };
+        std::vector<std::string> group;
+        while (depth > 0) {
+            token = nextToken();
+            if (token.kind == RBRACE) {
+                depth--;
+                continue;
+            }
+            if (token.kind == SEMICOLON || token.kind == COMMA) continue;
+
+            links = 0;
+            if (token.kind == LBRACE || isKeyword(token, "subgraph")) {
+                if (token.kind != LBRACE) {
+                    token = nextToken();
+                    if (token.kind == ID) token = nextToken();
+                    if (token.kind != LBRACE) return unexpected(token);
+                }
+                int result = parseGroup(group, onNode);
+                if (result < 0) return false;
+                if (result == 0) {
+                    depth++;
+                    continue;
+                }
+                if (peekToken().kind != EDGEOP) {
+                    for (const auto &name : group) {
+                        onNode(name);
+                        nodeCount++;
+                    }
+                    continue;
+                }
+                nextEndpoint().swap(group);
+            } else if (isKeyword(token, "graph") || isKeyword(token, "node") || isKeyword(token, "edge")) {
+                int weight;
+                bool hasWeight;
+                if (peekToken().kind != LBRACKET) return unexpected(peekToken());
+                if (!parseAttributes(weight, hasWeight)) return false;
+                continue;
+            } else if (token.kind == ID) {
+                if (peekToken().kind == EQUAL) { // Graph attribute: id = id
+                    nextToken();
+                    Token value = nextToken();
+                    if (value.kind != ID) return unexpected(value);
+                    continue;
+                }
+                if (!skipPort()) return false;
+                nextEndpoint().push_back(std::move(token.text));
+            } else {
+                return unexpected(token);
+            }
+
+            // Edge chain: endpoint (-- endpoint)*
+            while (peekToken().kind == EDGEOP) {
+                nextToken();
+                token = nextToken();
+                if (token.kind == LBRACE || isKeyword(token, "subgraph")) {
+                    if (token.kind != LBRACE) {
+                        token = nextToken();
+                        if (token.kind == ID) token = nextToken();
+                        if (token.kind != LBRACE) return unexpected(token);
+                    }
+                    if (parseGroup(group, onNode) != 1) return fail("only groups of node ids can be edge endpoints");
+                    nextEndpoint().swap(group);
+                } else if (token.kind == ID) {
+                    if (!skipPort()) return false;
+                    nextEndpoint().push_back(std::move(token.text));
+                } else {
+                    return unexpected(token);
+                }
+            }
+
+            int weight = 0;
+            bool hasWeight = false;
+            if (!parseAttributes(weight, hasWeight)) return false;
+            if (links == 1) {
+                for (const auto &name : chain[0]) {
+                    onNode(name);
+                    nodeCount++;
+                }
+                continue;
+            }
+            for (size_t i = 0; i + 1 < links; i++) {
+                for (const auto &from : chain[i]) {
+                    for (const auto &to : chain[i + 1]) {
+                        onEdge(from, to, weight, hasWeight);
+                        edgeCount++;
+                    }
+                }
+            }
+        }
+
+        token = nextToken();
+        if (token.kind != END) return fail("text after the closing brace");
+        return true;
+    }
+};
+
+// Add the edges and nodes of a DOT file to an undirected adjacency-list graph (every edge stored
+// in both endpoints' lists), reading it in one streaming pass. Weighted lists get weight 1 for
+// edges without one. Returns false, with the reason in `error`, if the file could not be read.
+template <typename AdjList>
+bool readUndirectedDot(AdjList &adjList, const std::string &filename, std::string *error = nullptr) {
+    DotReader reader;
+    bool ok = reader.read(filename,
+                          [&adjList](const std::string &from, const std::string &to, int weight, bool hasWeight) {
+                              dotAddNeighbor(adjList[from], to, hasWeight ? weight : 1);
+                              dotAddNeighbor(adjList[to], from, hasWeight ? weight : 1);
+                          },
+                          [&adjList](const std::string &name) { adjList[name]; });
+    if (!ok && error) *error = reader.error;
+    return ok;
+}
+
+#endif
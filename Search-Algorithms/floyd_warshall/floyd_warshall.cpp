@@ -0,0 +1,469 @@
+#include <iostream>
+#include <fstream>
+#include <unordered_map>
+#include <vector>
+#include <string>
+#include <atomic>
+#include <thread>
+#include <algorithm>
+#include <functional>
+#include <cstdint>
+#include <cstdlib>  // For system()
+#include <limits>   // For std::numeric_limits
+
+#if defined(__AVX512F__) || defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+// Distances are 32-bit so a vector register holds 8 (AVX2) or 16 (AVX-512) of them.
+// INF is small enough that INF + INF does not overflow.
+const int32_t INF = std::numeric_limits<int32_t>::max() / 4;
+
+// Tiles are TILE x TILE blocks of the matrix: 64 x 64 x 4 bytes = 16 KB, so the three tiles a
+// kernel touches stay in the L1/L2 cache
+const int TILE = 64;
+
+// All-pairs shortest paths: distance[i * stride + j], and optionally the first hop of a shortest
+// path from i to j (-1 if none). Weights must be non-negative and below INF; zero is allowed. With next hops,
+// ties in distance go to the path with fewer edges (hops[i * stride + j]), so that with zero-weight
+// edges a next hop never leads back to a node already on the path.
+struct AllPairsResult {
+    std::vector<std::string> nodes; // Node names, indexed by node id
+    size_t stride = 0;              // Row length (node count rounded up to a whole tile)
+    std::vector<int32_t> distance;
+    std::vector<int32_t> next;      // Empty unless requested
+    std::vector<int32_t> hops;      // Edges on the path, INF if none; with `next` only
+
+    int32_t dist(size_t i, size_t j) const {
+        return distance[i * stride + j];
+    }
+
+    // Node ids along a shortest path, empty if there is none (needs the next-hop matrix)
+    std::vector<int> path(int from, int to) const {
+        if (next.empty() || distance[from * stride + to] >= INF) return {};
+        std::vector<int> result = {from};
+        while (from != to) {
+            if (result.size() > nodes.size()) return {}; // Inconsistent next hops; never loop forever
+            from = next[from * stride + to];
+            if (from < 0) return {};
+            result.push_back(from);
+        }
+        return result;
+    }
+};
+
+// Run fn(t) on numThreads threads
+void runThreads(int numThreads, const std::function<void(int)> &fn) {
+    if (numThreads <= 1) {
+        fn(0);
+        return;
+    }
+    std::vector<std::thread> workers;
+    for (int t = 0; t < numThreads; t++) {
+        workers.emplace_back(fn, t);
+    }
+    for (auto &worker : workers) {
+        worker.join();
+    }
+}
+
+// Next-hop tracking for a min-plus update: the next-hop tiles of C and A, and the hop-count tiles
+// of C, A and B. All null when only distances are wanted.
+struct HopTiles {
+    int32_t *nextC;
+    const int32_t *nextA;
+    int32_t *countC;
+    const int32_t *countA;
+    const int32_t *countB;
+};
+
+// Min-plus update of tile C through the tiles A (rows of C, columns k) and B (rows k, columns of C):
+//   C[i][j] = min(C[i][j], A[i][k] + B[k][j]) for every k of the tile, in order.
+// k is the outer loop, so this is also correct when C is A or B (the diagonal and row/column
+// phases). With next-hop tracking, (distance, hop count) pairs are compared, and an improved
+// entry takes the first hop toward k.
+void minPlusTile(int32_t *c, const int32_t *a, const int32_t *b, const HopTiles &h, size_t stride) {
+    for (int k = 0; k < TILE; k++) {
+        const int32_t *bRow = b + k * stride;
+        const int32_t *countBRow = h.nextC ? h.countB + k * stride : nullptr;
+        for (int i = 0; i < TILE; i++) {
+            int32_t aik = a[i * stride + k];
+            if (aik >= INF) continue;
+            int32_t *cRow = c + i * stride;
+            int32_t *nextRow = h.nextC ? h.nextC + i * stride : nullptr;
+            int32_t *countRow = h.nextC ? h.countC + i * stride : nullptr;
+            int j = 0;
+#if defined(__AVX512F__)
+            __m512i va = _mm512_set1_epi32(aik);
+            if (nextRow) {
+                __m512i hop = _mm512_set1_epi32(h.nextA[i * stride + k]);
+                __m512i vcount = _mm512_set1_epi32(h.countA[i * stride + k]);
+                for (; j < TILE; j += 16) {
+                    __m512i sum = _mm512_add_epi32(va, _mm512_loadu_si512(bRow + j));
+                    __m512i current = _mm512_loadu_si512(cRow + j);
+                    __m512i countSum = _mm512_add_epi32(vcount, _mm512_loadu_si512(countBRow + j));
+                    __mmask16 better = _mm512_cmplt_epi32_mask(sum, current) |
+                                       _mm512_mask_cmplt_epi32_mask(_mm512_cmpeq_epi32_mask(sum, current), countSum,
+                                                                    _mm512_loadu_si512(countRow + j));
+                    _mm512_storeu_si512(cRow + j, _mm512_mask_mov_epi32(current, better, sum));
+                    _mm512_mask_storeu_epi32(nextRow + j, better, hop);
+                    _mm512_mask_storeu_epi32(countRow + j, better, countSum);
+                }
+            } else {
+                for (; j < TILE; j += 16) {
+                    __m512i sum = _mm512_add_epi32(va, _mm512_loadu_si512(bRow + j));
+                    __m512i current = _mm512_loadu_si512(cRow + j);
+                    _mm512_storeu_si512(cRow + j, _mm512_mask_mov_epi32(current, _mm512_cmplt_epi32_mask(sum, current), sum));
+                }
+            }
+#elif defined(__AVX2__)
+            __m256i va = _mm256_set1_epi32(aik);
+            if (nextRow) {
+                __m256i hop = _mm256_set1_epi32(h.nextA[i * stride + k]);
+                __m256i vcount = _mm256_set1_epi32(h.countA[i * stride + k]);
+                for (; j < TILE; j += 8) {
+                    __m256i sum = _mm256_add_epi32(va, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(bRow + j)));
+                    __m256i current = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(cRow + j));
+                    __m256i countSum = _mm256_add_epi32(vcount, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(countBRow + j)));
+                    __m256i count = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(countRow + j));
+                    __m256i better = _mm256_or_si256(_mm256_cmpgt_epi32(current, sum),
+                                                     _mm256_and_si256(_mm256_cmpeq_epi32(current, sum), _mm256_cmpgt_epi32(count, countSum)));
+                    _mm256_storeu_si256(reinterpret_cast<__m256i*>(cRow + j), _mm256_min_epi32(sum, current));
+                    __m256i oldHop = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(nextRow + j));
+                    _mm256_storeu_si256(reinterpret_cast<__m256i*>(nextRow + j), _mm256_blendv_epi8(oldHop, hop, better));
+                    _mm256_storeu_si256(reinterpret_cast<__m256i*>(countRow + j), _mm256_blendv_epi8(count, countSum, better));
+                }
+            } else {
+                for (; j < TILE; j += 8) {
+                    __m256i sum = _mm256_add_epi32(va, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(bRow + j)));
+                    __m256i current = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(cRow + j));
+                    _mm256_storeu_si256(reinterpret_cast<__m256i*>(cRow + j), _mm256_min_epi32(sum, current));
+                }
+            }
+#else
+            if (nextRow) {
+                int32_t hop = h.nextA[i * stride + k];
+                int32_t count = h.countA[i * stride + k];
+                for (; j < TILE; j++) {
+                    int32_t sum = aik + bRow[j];
+                    int32_t countSum = count + countBRow[j];
+                    if (sum < cRow[j] || (sum == cRow[j] && countSum < countRow[j])) {
+                        cRow[j] = sum;
+                        nextRow[j] = hop;
+                        countRow[j] = countSum;
+                    }
+                }
+            } else {
+                for (; j < TILE; j++) {
+                    cRow[j] = std::min(cRow[j], aik + bRow[j]);
+                }
+            }
+#endif
+        }
+    }
+}
+
+// The same update when C overlaps neither A nor B (every tile off row and column kk). Then k can
+// be the inner loop, and each row of C, with its next hops, stays in vector registers while all
+// TILE values of k are applied.
+void minPlusTileIndependent(int32_t *c, const int32_t *a, const int32_t *b, const HopTiles &h, size_t stride) {
+#if defined(__AVX512F__) || defined(__AVX2__)
+#if defined(__AVX512F__)
+    typedef __m512i Vector;
+    const int LANES = 16;
+    auto load = [](const int32_t *p) { return _mm512_loadu_si512(p); };
+    auto store = [](int32_t *p, Vector v) { _mm512_storeu_si512(p, v); };
+    auto broadcast = [](int32_t x) { return _mm512_set1_epi32(x); };
+    auto add = [](Vector x, Vector y) { return _mm512_add_epi32(x, y); };
+    auto minimum = [](Vector x, Vector y) { return _mm512_min_epi32(x, y); };
+    // Where (sum, countSum) < (current, count): take sum, newHop and countSum
+    auto improve = [](Vector sum, Vector &current, Vector newHop, Vector &hop, Vector countSum, Vector &count) {
+        __mmask16 better = _mm512_cmplt_epi32_mask(sum, current) |
+                           _mm512_mask_cmplt_epi32_mask(_mm512_cmpeq_epi32_mask(sum, current), countSum, count);
+        current = _mm512_mask_mov_epi32(current, better, sum);
+        hop = _mm512_mask_mov_epi32(hop, better, newHop);
+        count = _mm512_mask_mov_epi32(count, better, countSum);
+    };
+#else
+    typedef __m256i Vector;
+    const int LANES = 8;
+    auto load = [](const int32_t *p) { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)); };
+    auto store = [](int32_t *p, Vector v) { _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), v); };
+    auto broadcast = [](int32_t x) { return _mm256_set1_epi32(x); };
+    auto add = [](Vector x, Vector y) { return _mm256_add_epi32(x, y); };
+    auto minimum = [](Vector x, Vector y) { return _mm256_min_epi32(x, y); };
+    auto improve = [](Vector sum, Vector &current, Vector newHop, Vector &hop, Vector countSum, Vector &count) {
+        Vector better = _mm256_or_si256(_mm256_cmpgt_epi32(current, sum),
+                                        _mm256_and_si256(_mm256_cmpeq_epi32(current, sum), _mm256_cmpgt_epi32(count, countSum)));
+        hop = _mm256_blendv_epi8(hop, newHop, better);
+        count = _mm256_blendv_epi8(count, countSum, better);
+        current = _mm256_min_epi32(current, sum);
+    };
+#endif
+    const int VECTORS = TILE / LANES;
+    bool tracked = h.nextC != nullptr;
+    for (int i = 0; i < TILE; i++) {
+        int32_t *cRow = c + i * stride;
+        const int32_t *aRow = a + i * stride;
+        Vector row[VECTORS], hops[VECTORS], counts[VECTORS];
+        for (int q = 0; q < VECTORS; q++) {
+            row[q] = load(cRow + q * LANES);
+            if (tracked) {
+                hops[q] = load(h.nextC + i * stride + q * LANES);
+                counts[q] = load(h.countC + i * stride + q * LANES);
+            }
+        }
+        for (int k = 0; k < TILE; k++) {
+            int32_t aik = aRow[k];
+            if (aik >= INF) continue;
+            Vector va = broadcast(aik);
+            const int32_t *bRow = b + k * stride;
+            if (tracked) {
+                Vector hop = broadcast(h.nextA[i * stride + k]);
+                Vector count = broadcast(h.countA[i * stride + k]);
+                const int32_t *countBRow = h.countB + k * stride;
+                for (int q = 0; q < VECTORS; q++) {
+                    improve(add(va, load(bRow + q * LANES)), row[q], hop, hops[q], add(count, load(countBRow + q * LANES)), counts[q]);
+                }
+            } else {
+                for (int q = 0; q < VECTORS; q++) {
+                    row[q] = minimum(row[q], add(va, load(bRow + q * LANES)));
+                }
+            }
+        }
+        for (int q = 0; q < VECTORS; q++) {
+            store(cRow + q * LANES, row[q]);
+            if (tracked) {
+                store(h.nextC + i * stride + q * LANES, hops[q]);
+                store(h.countC + i * stride + q * LANES, counts[q]);
+            }
+        }
+    }
+#else
+    minPlusTile(c, a, b, h, stride);
+#endif
+}
+
+class Graph {
+public:
+    std::unordered_map<std::string, std::vector<std::pair<std::string, int>>> adjList;
+
+    // Add an edge with a weight between two variables (for an undirected graph)
+    void addEdge(const std::string &var1, const std::string &var2, int weight) {
+        adjList[var1].push_back({var2, weight});
+        adjList[var2].push_back({var1, weight});
+    }
+
+    // Export the graph to a DOT file for Graphviz visualization
+    void exportGraphToDot(const std::string &filename) {
+        std::ofstream dotFile;
+        dotFile.open(filename);
+
+        dotFile << "graph G {\n";
+        for (const auto &node : adjList) {
+            for (const auto &neighbor : node.second) {
+                if (node.first < neighbor.first) { // Avoid double printing edges in undirected graph
+                    dotFile << "  " << node.first << " -- " << neighbor.first << " [label=\"" << neighbor.second << "\"];\n";
+                }
+            }
+        }
+        dotFile << "}\n";
+        dotFile.close();
+
+        std::cout << "Graph exported to " << filename << " successfully." << std::endl;
+    }
+
+    // Blocked Floyd-Warshall over the whole graph.
+    // For each diagonal tile kk in turn: (1) close tile (kk, kk) on its own; (2) update the tiles
+    // in row kk and column kk through it; (3) update every other tile (i, j) through (i, kk) and
+    // (kk, j). Tiles within phases 2 and 3 are independent, so threads take them from a shared
+    // counter.
+    // Fails on a negative weight, a weight of INF or more, or a distance too long to tell from INF.
+    bool allPairsShortestPaths(AllPairsResult &result, int numThreads, bool withNextHop) {
+        result = AllPairsResult();
+        std::unordered_map<std::string, int> ids;
+        for (const auto &node : adjList) {
+            ids[node.first] = static_cast<int>(result.nodes.size());
+            result.nodes.push_back(node.first);
+        }
+        size_t n = result.nodes.size();
+        size_t tiles = (n + TILE - 1) / TILE;
+        size_t stride = tiles * TILE;
+        result.stride = stride;
+
+        // Padding rows and columns stay unreachable and never improve anything
+        std::vector<int32_t> &d = result.distance;
+        d.assign(stride * stride, INF);
+        if (withNextHop) {
+            result.next.assign(stride * stride, -1);
+            result.hops.assign(stride * stride, INF);
+        }
+        for (size_t i = 0; i < n; i++) {
+            d[i * stride + i] = 0;
+            if (withNextHop) {
+                result.next[i * stride + i] = static_cast<int32_t>(i);
+                result.hops[i * stride + i] = 0;
+            }
+            for (const auto &neighbor : adjList[result.nodes[i]]) {
+                if (neighbor.second < 0 || neighbor.second >= INF) return false;
+                size_t j = ids[neighbor.first];
+                if (i != j && neighbor.second < d[i * stride + j]) { // A self-loop never shortens anything
+                    d[i * stride + j] = neighbor.second;
+                    if (withNextHop) {
+                        result.next[i * stride + j] = static_cast<int32_t>(j);
+                        result.hops[i * stride + j] = 1;
+                    }
+                }
+            }
+        }
+
+        int32_t *next = withNextHop ? result.next.data() : nullptr;
+        auto tile = [&](std::vector<int32_t> &matrix, size_t ti, size_t tj) {
+            return matrix.data() + ti * TILE * stride + tj * TILE;
+        };
+        auto update = [&](size_t ti, size_t tj, size_t kk) {
+            auto kernel = ti == kk || tj == kk ? minPlusTile : minPlusTileIndependent;
+            HopTiles h = {nullptr, nullptr, nullptr, nullptr, nullptr};
+            if (next) {
+                h = {tile(result.next, ti, tj), tile(result.next, ti, kk), tile(result.hops, ti, tj),
+                     tile(result.hops, ti, kk), tile(result.hops, kk, tj)};
+            }
+            kernel(tile(d, ti, tj), tile(d, ti, kk), tile(d, kk, tj), h, stride);
+        };
+        numThreads = std::max(1, std::min<int>(numThreads, static_cast<int>(tiles * tiles)));
+
+        for (size_t kk = 0; kk < tiles; kk++) {
+            update(kk, kk, kk);
+
+            // Row kk and column kk: 2 * (tiles - 1) tiles
+            std::atomic<size_t> counter{0};
+            runThreads(std::min<int>(numThreads, static_cast<int>(2 * tiles)), [&](int) {
+                for (size_t w; (w = counter.fetch_add(1)) < 2 * tiles;) {
+                    size_t other = w / 2;
+                    if (other == kk) continue;
+                    if (w % 2 == 0) {
+                        update(kk, other, kk);
+                    } else {
+                        update(other, kk, kk);
+                    }
+                }
+            });
+
+            // Everything else
+            counter.store(0);
+            runThreads(numThreads, [&](int) {
+                for (size_t w; (w = counter.fetch_add(1)) < tiles * tiles;) {
+                    size_t ti = w / tiles, tj = w % tiles;
+                    if (ti == kk || tj == kk) continue;
+                    update(ti, tj, kk);
+                }
+            });
+        }
+
+        // Sums never exceed INF, so a distance of INF or more comes out as INF. Within a connected
+        // component every pair must then have a finite distance.
+        std::vector<int> component(n, -1);
+        std::vector<size_t> queue;
+        for (size_t root = 0; root < n; root++) {
+            if (component[root] >= 0) continue;
+            component[root] = static_cast<int>(root);
+            queue.assign(1, root);
+            for (size_t head = 0; head < queue.size(); head++) {
+                for (const auto &neighbor : adjList[result.nodes[queue[head]]]) {
+                    size_t v = ids[neighbor.first];
+                    if (component[v] < 0) {
+                        component[v] = static_cast<int>(root);
+                        queue.push_back(v);
+                    }
+                }
+            }
+        }
+        for (size_t i = 0; i < n; i++) {
+            for (size_t j = 0; j < n; j++) {
+                if (component[i] == component[j] && d[i * stride + j] >= INF) return false;
+            }
+        }
+        return true;
+    }
+};
+
+int main() {
+    Graph graph;
+
+    // Define the relationships (edges between variables) with weights
+    graph.addEdge("x", "y", 4);
+    graph.addEdge("y", "z", 6);
+    graph.addEdge("x", "a", 2);
+    graph.addEdge("a", "b", 5);
+    graph.addEdge("b", "z", 3);
+    graph.addEdge("a", "y", 1);
+
+    // Export the graph to a DOT file for Graphviz visualization
+    std::string dotFilename = "graph_output.dot";
+    graph.exportGraphToDot(dotFilename);
+
+    // Use Graphviz to generate a PNG image of the graph
+    std::string graphImage = "graph_output.png";
+    std::string dotCommand = "dot -Tpng " + dotFilename + " -o " + graphImage;
+    system(dotCommand.c_str());  // Execute the dot command to generate the PNG image
+
+    // Open the PNG image using the default image viewer
+    #if defined(_WIN32) || defined(_WIN64)
+        system(("start " + graphImage).c_str()); // Windows
+    #elif defined(__APPLE__)
+        system(("open " + graphImage).c_str());  // macOS
+    #else
+        system(("xdg-open " + graphImage).c_str());  // Linux
+    #endif
+
+    // Full distance matrix, with next hops for path recovery
+    int numThreads = static_cast<int>(std::thread::hardware_concurrency());
+    AllPairsResult result;
+    if (!graph.allPairsShortestPaths(result, numThreads, true)) {
+        std::cout << "Weights must be from 0 to " << INF - 1 << " and distances below " << INF << ".\n";
+        return 0;
+    }
+
+    std::cout << "Distance matrix:\n    ";
+    for (const auto &name : result.nodes) std::cout << "\t" << name;
+    std::cout << "\n";
+    for (size_t i = 0; i < result.nodes.size(); i++) {
+        std::cout << "  " << result.nodes[i];
+        for (size_t j = 0; j < result.nodes.size(); j++) {
+            std::cout << "\t";
+            if (result.dist(i, j) >= INF) {
+                std::cout << "-";
+            } else {
+                std::cout << result.dist(i, j);
+            }
+        }
+        std::cout << "\n";
+    }
+
+    // Now ask the user for source and destination
+    std::string source, destination;
+
+    std::cout << "Enter the source variable: ";
+    std::getline(std::cin, source);
+    std::cout << "Enter the destination variable: ";
+    std::getline(std::cin, destination);
+
+    auto from = std::find(result.nodes.begin(), result.nodes.end(), source);
+    auto to = std::find(result.nodes.begin(), result.nodes.end(), destination);
+    if (from == result.nodes.end() || to == result.nodes.end()) {
+        std::cout << "Unknown variable.\n";
+        return 0;
+    }
+    std::vector<int> path = result.path(static_cast<int>(from - result.nodes.begin()), static_cast<int>(to - result.nodes.begin()));
+    if (path.empty()) {
+        std::cout << "No path found from " << source << " to " << destination << ".\n";
+        return 0;
+    }
+    std::cout << "Path found: ";
+    for (int node : path) {
+        std::cout << result.nodes[node] << " -> ";
+    }
+    std::cout << "END (cost " << result.dist(path.front(), path.back()) << ")" << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,310 @@
+#include <iostream>
+#include <fstream>
+#include <unordered_map>
+#include <vector>
+#include <queue>
+#include <tuple>
+#include <string>
+#include <atomic>
+#include <thread>
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>  // For system()
+#include <limits>   // For std::numeric_limits
+
+const long long INF = std::numeric_limits<long long>::max();
+
+// A generated node sent to the worker that owns it
+struct Message {
+    int node;
+    long long gCost;
+    int parent;
+};
+
+// A batch of messages, linked into a worker's inbox
+struct MessageBatch {
+    std::vector<Message> items;
+    MessageBatch *next = nullptr;
+};
+
+// Lock-free multi-producer / single-consumer inbox (a Treiber stack of batches).
+// Senders push whole batches with a CAS; the owner takes everything at once with an exchange.
+class MessageQueue {
+public:
+    std::atomic<MessageBatch*> head{nullptr};
+
+    void push(MessageBatch *batch) {
+        batch->next = head.load(std::memory_order_relaxed);
+        while (!head.compare_exchange_weak(batch->next, batch, std::memory_order_release, std::memory_order_relaxed)) {
+        }
+    }
+
+    MessageBatch *takeAll() {
+        return head.exchange(nullptr, std::memory_order_acquire);
+    }
+};
+
+class Graph {
+public:
+    std::unordered_map<std::string, std::vector<std::pair<std::string, int>>> adjList;
+
+    // Add an edge with a weight between two variables (for an undirected graph)
+    void addEdge(const std::string &var1, const std::string &var2, int weight) {
+        adjList[var1].push_back({var2, weight});
+        adjList[var2].push_back({var1, weight});
+    }
+
+    // Export the graph to a DOT file for Graphviz visualization
+    void exportGraphToDot(const std::string &filename) {
+        std::ofstream dotFile;
+        dotFile.open(filename);
+
+        dotFile << "graph G {\n";
+        for (const auto &node : adjList) {
+            for (const auto &neighbor : node.second) {
+                if (node.first < neighbor.first) { // Avoid double printing edges in undirected graph
+                    dotFile << "  " << node.first << " -- " << neighbor.first << " [label=\"" << neighbor.second << "\"];\n";
+                }
+            }
+        }
+        dotFile << "}\n";
+        dotFile.close();
+
+        std::cout << "Graph exported to " << filename << " successfully." << std::endl;
+    }
+
+    // Heuristic function (example: Manhattan distance based on alphabetical order)
+    double heuristic(const std::string &node, const std::string &goal) {
+        return std::abs(static_cast<int>(node[0]) - static_cast<int>(goal[0]));
+    }
+
+    // Hash-distributed A* (HDA*).
+    // Every node is owned by the worker hash(node) % numThreads, which keeps its open list and
+    // g-values. Generated nodes owned by another worker are buffered and sent in batches through
+    // that worker's lock-free inbox. The search stops only when every worker is idle and no
+    // message is in flight, so the incumbent goal cost is optimal for an admissible heuristic.
+    void hdaStar(const std::string &source, const std::string &destination, int numThreads, size_t batchSize = 64) {
+        std::cout << "Starting HDA* Search from " << source << " to " << destination
+                  << " with " << numThreads << " threads...\n";
+
+        if (adjList.find(source) == adjList.end() || adjList.find(destination) == adjList.end()) {
+            std::cout << "No path found from " << source << " to " << destination << ".\n";
+            return;
+        }
+        numThreads = std::max(1, numThreads);
+
+        // Flatten the graph into integer ids with a precomputed heuristic and owner per node
+        std::vector<std::string> names;
+        std::unordered_map<std::string, int> ids;
+        for (const auto &node : adjList) {
+            ids[node.first] = static_cast<int>(names.size());
+            names.push_back(node.first);
+        }
+        size_t n = names.size();
+        std::vector<size_t> offsets(n + 1, 0);
+        std::vector<int> targets;
+        std::vector<int> weights;
+        std::vector<double> hCost(n);
+        std::vector<int> owner(n);
+        for (size_t u = 0; u < n; u++) {
+            for (const auto &neighbor : adjList[names[u]]) {
+                targets.push_back(ids[neighbor.first]);
+                weights.push_back(neighbor.second);
+            }
+            offsets[u + 1] = targets.size();
+            hCost[u] = heuristic(names[u], destination);
+            owner[u] = static_cast<int>(std::hash<std::string>()(names[u]) % numThreads);
+        }
+        int start = ids[source];
+        int goal = ids[destination];
+
+        // g-values and parents; each entry is only ever touched by the node's owner
+        std::vector<long long> gBest(n, INF);
+        std::vector<int> parent(n, -1);
+
+        std::vector<MessageQueue> inbox(numThreads);
+        std::atomic<long long> incumbent{INF};
+        // Active workers plus undelivered messages; the search is finished when it reaches zero
+        std::atomic<long long> work{numThreads};
+        std::vector<long long> expansions(numThreads, 0);
+
+        auto worker = [&](int self) {
+            typedef std::tuple<double, long long, int> OpenEntry; // (f, g, node)
+            std::priority_queue<OpenEntry, std::vector<OpenEntry>, std::greater<>> open;
+            std::vector<MessageBatch*> outbox(numThreads, nullptr);
+            bool active = true;
+
+            auto flush = [&](int dest) {
+                if (outbox[dest] && !outbox[dest]->items.empty()) {
+                    // Count the messages before publishing them, so work never reads zero too early
+                    work.fetch_add(static_cast<long long>(outbox[dest]->items.size()));
+                    inbox[dest].push(outbox[dest]);
+                    outbox[dest] = nullptr;
+                }
+            };
+
+            // Offer a node to its owner's g-table and open list (only called by the owner)
+            auto offer = [&](const Message &msg) {
+                if (msg.gCost < gBest[msg.node] && msg.gCost + hCost[msg.node] < incumbent.load(std::memory_order_relaxed)) {
+                    gBest[msg.node] = msg.gCost;
+                    parent[msg.node] = msg.parent;
+                    open.push({msg.gCost + hCost[msg.node], msg.gCost, msg.node});
+                }
+            };
+
+            if (owner[start] == self) {
+                offer({start, 0, -1});
+            }
+
+            while (true) {
+                // Receive every batch sent to this worker
+                MessageBatch *batch = inbox[self].takeAll();
+                while (batch) {
+                    MessageBatch *next = batch->next;
+                    long long received = static_cast<long long>(batch->items.size());
+                    for (const auto &msg : batch->items) {
+                        offer(msg);
+                    }
+                    // An idle worker becomes active again in the same atomic step that consumes the messages
+                    work.fetch_add(active ? -received : 1 - received);
+                    active = true;
+                    delete batch;
+                    batch = next;
+                }
+
+                // Discard stale entries and entries that cannot beat the incumbent
+                while (!open.empty()) {
+                    auto [fCost, gCost, node] = open.top();
+                    if (gCost > gBest[node] || fCost >= incumbent.load(std::memory_order_relaxed)) {
+                        open.pop();
+                        continue;
+                    }
+                    break;
+                }
+
+                if (open.empty()) {
+                    // Nothing left to expand locally: send everything buffered, then go idle
+                    for (int dest = 0; dest < numThreads; dest++) {
+                        flush(dest);
+                    }
+                    if (active) {
+                        active = false;
+                        work.fetch_sub(1);
+                    }
+                    if (work.load() == 0) {
+                        break;
+                    }
+                    std::this_thread::yield();
+                    continue;
+                }
+
+                auto [fCost, gCost, node] = open.top();
+                open.pop();
+                expansions[self]++;
+
+                // Goal reached: record it as the incumbent, but keep searching until optimality is proven
+                if (node == goal) {
+                    long long best = incumbent.load();
+                    while (gCost < best && !incumbent.compare_exchange_weak(best, gCost)) {
+                    }
+                    continue;
+                }
+
+                // Expand the node, keeping owned children local and batching the rest
+                for (size_t e = offsets[node]; e < offsets[node + 1]; e++) {
+                    Message child{targets[e], gCost + weights[e], node};
+                    int dest = owner[child.node];
+                    if (dest == self) {
+                        offer(child);
+                        continue;
+                    }
+                    if (!outbox[dest]) {
+                        outbox[dest] = new MessageBatch();
+                    }
+                    outbox[dest]->items.push_back(child);
+                    if (outbox[dest]->items.size() >= batchSize) {
+                        flush(dest);
+                    }
+                }
+            }
+        };
+
+        std::vector<std::thread> threads;
+        for (int t = 0; t < numThreads; t++) {
+            threads.emplace_back(worker, t);
+        }
+        for (auto &thread : threads) {
+            thread.join();
+        }
+
+        long long totalExpansions = 0;
+        for (long long count : expansions) {
+            totalExpansions += count;
+        }
+
+        if (incumbent.load() == INF) {
+            std::cout << "No path found from " << source << " to " << destination << ".\n";
+            return;
+        }
+
+        // Reconstruct the path by following parents back from the goal
+        std::vector<std::string> path;
+        for (int node = goal; node != -1 && path.size() <= n; node = parent[node]) {
+            path.push_back(names[node]);
+        }
+        std::reverse(path.begin(), path.end());
+
+        std::cout << "Path found with total cost " << incumbent.load() << ": ";
+        for (const auto &node : path) {
+            std::cout << node << " -> ";
+        }
+        std::cout << "END" << std::endl;
+        std::cout << "Nodes expanded: " << totalExpansions << std::endl;
+    }
+};
+
+int main() {
+    Graph graph;
+
+    // Define the relationships (edges between variables) with weights
+    graph.addEdge("A", "B", 4);
+    graph.addEdge("A", "C", 2);
+    graph.addEdge("B", "D", 5);
+    graph.addEdge("C", "D", 8);
+    graph.addEdge("C", "E", 10);
+    graph.addEdge("D", "E", 2);
+    graph.addEdge("D", "F", 6);
+    graph.addEdge("E", "F", 3);
+
+    // Export the graph to a DOT file for Graphviz visualization
+    std::string dotFilename = "graph_output.dot";
+    graph.exportGraphToDot(dotFilename);
+
+    // Use Graphviz to generate a PNG image of the graph
+    std::string graphImage = "graph_output.png";
+    std::string dotCommand = "dot -Tpng " + dotFilename + " -o " + graphImage;
+    system(dotCommand.c_str());  // Execute the dot command to generate the PNG image
+
+    // Open the PNG image using the default image viewer
+    #if defined(_WIN32) || defined(_WIN64)
+        system(("start " + graphImage).c_str()); // Windows
+    #elif defined(__APPLE__)
+        system(("open " + graphImage).c_str());  // macOS
+    #else
+        system(("xdg-open " + graphImage).c_str());  // Linux
+    #endif
+
+    // Now ask the user for source and destination
+    std::string source, destination;
+
+    std::cout << "Enter the source node: ";
+    std::getline(std::cin, source);
+    std::cout << "Enter the destination node: ";
+    std::getline(std::cin, destination);
+
+    // Perform HDA* Search from source to destination on every available core
+    int numThreads = static_cast<int>(std::thread::hardware_concurrency());
+    graph.hdaStar(source, destination, numThreads);
+
+    return 0;
+}
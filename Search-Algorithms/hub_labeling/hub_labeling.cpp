@@ -0,0 +1,440 @@
+#include <iostream>
+#include <fstream>
+#include <unordered_map>
+#include <vector>
+#include <queue>
+#include <string>
+#include <thread>
+#include <algorithm>
+#include <functional>
+#include <cstdint>
+#include <cstdlib>  // For system()
+#include <limits>   // For std::numeric_limits
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+const long long INF = std::numeric_limits<long long>::max();
+
+// Hub labels: every node keeps a list of (hub, distance) pairs such that any two nodes share a
+// hub on one of their shortest paths. The distance between s and t is then the minimum of
+// d(s, hub) + d(hub, t) over their common hubs, found by merging two sorted lists.
+//
+// Labels are built by pruned landmark labeling: a Dijkstra search is run from every node in order
+// of importance (most shortest paths through it first), and it stops expanding at any node whose
+// distance the labels found so far already answer. Early, important hubs cover most shortest paths, so later
+// searches stay small. Hubs are numbered by that order, so every label comes out sorted.
+//
+// All labels are stored in two flat arrays (hubs, distances) with per-node offsets, so a label is
+// a contiguous, sorted array of 32-bit hubs that AVX2 can intersect eight at a time. Label
+// distances are capped at MAX_DISTANCE (31 bits) so that the sum of two always fits in 32 bits.
+class HubLabels {
+public:
+    std::vector<std::string> nodes;                  // Node names, indexed by node id
+    std::unordered_map<std::string, uint32_t> ids;   // Node id of each name
+
+    static constexpr uint32_t MAX_DISTANCE = std::numeric_limits<int32_t>::max();
+
+    // Build from a CSR graph: node u's edges are targets/weights[offsets[u] .. offsets[u + 1]).
+    // Searches run in 64-bit; returns false if some label distance exceeds MAX_DISTANCE.
+    bool build(const std::vector<size_t> &offsets, const std::vector<uint32_t> &targets,
+               const std::vector<uint32_t> &weights) {
+        uint32_t n = static_cast<uint32_t>(nodes.size());
+        typedef std::pair<uint64_t, uint32_t> Entry; // (distance, node)
+        const uint64_t UNSEEN = std::numeric_limits<uint64_t>::max();
+
+        // Importance: how many shortest paths pass through a node, estimated from the sizes of its
+        // subtrees in the shortest path trees of a few sample roots; ties go to higher degree
+        std::vector<uint64_t> importance(n, 0);
+        std::vector<uint64_t> distance(n, UNSEEN);
+        std::vector<uint32_t> parent(n);
+        std::vector<uint32_t> settled;
+        uint32_t samples = std::min<uint32_t>(n, 16);
+        for (uint32_t sample = 0; sample < samples; sample++) {
+            uint32_t root = static_cast<uint32_t>(static_cast<uint64_t>(sample) * n / samples);
+            std::fill(distance.begin(), distance.end(), UNSEEN);
+            std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> queue;
+            distance[root] = 0;
+            parent[root] = root;
+            queue.push({0, root});
+            settled.clear();
+            while (!queue.empty()) {
+                Entry top = queue.top();
+                queue.pop();
+                uint32_t u = top.second;
+                if (top.first > distance[u]) continue;
+                settled.push_back(u);
+                for (size_t e = offsets[u]; e < offsets[u + 1]; e++) {
+                    uint32_t v = targets[e];
+                    if (top.first + weights[e] < distance[v]) {
+                        distance[v] = top.first + weights[e];
+                        parent[v] = u;
+                        queue.push({distance[v], v});
+                    }
+                }
+            }
+            std::vector<uint64_t> subtree(n, 0);
+            for (size_t k = settled.size(); k-- > 0;) {
+                uint32_t u = settled[k];
+                subtree[u]++;
+                importance[u] += subtree[u];
+                if (u != root) subtree[parent[u]] += subtree[u];
+            }
+        }
+        std::fill(distance.begin(), distance.end(), UNSEEN);
+
+        std::vector<uint32_t> order(n);
+        for (uint32_t v = 0; v < n; v++) order[v] = v;
+        std::stable_sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) {
+            if (importance[a] != importance[b]) return importance[a] > importance[b];
+            return offsets[a + 1] - offsets[a] > offsets[b + 1] - offsets[b];
+        });
+
+        std::vector<std::vector<std::pair<uint32_t, uint32_t>>> labels(n); // (hub, distance) per node
+        std::vector<uint32_t> rootDistance(n, NO_DISTANCE); // The root's label, indexed by hub
+        std::vector<uint32_t> touched;
+
+        for (uint32_t hub = 0; hub < n; hub++) {
+            uint32_t root = order[hub];
+            for (const auto &entry : labels[root]) rootDistance[entry.first] = entry.second;
+
+            std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> queue;
+            distance[root] = 0;
+            touched.push_back(root);
+            queue.push({0, root});
+            while (!queue.empty()) {
+                Entry top = queue.top();
+                queue.pop();
+                uint32_t u = top.second;
+                if (top.first > distance[u]) continue;
+
+                // Prune: an earlier hub already gives a path this short
+                bool covered = false;
+                for (const auto &entry : labels[u]) {
+                    if (rootDistance[entry.first] != NO_DISTANCE &&
+                        static_cast<uint64_t>(rootDistance[entry.first]) + entry.second <= top.first) {
+                        covered = true;
+                        break;
+                    }
+                }
+                if (covered) continue;
+
+                if (top.first > MAX_DISTANCE) return false;
+                labels[u].push_back({hub, static_cast<uint32_t>(top.first)});
+                for (size_t e = offsets[u]; e < offsets[u + 1]; e++) {
+                    uint32_t v = targets[e];
+                    uint64_t candidate = top.first + weights[e];
+                    if (candidate < distance[v]) {
+                        if (distance[v] == UNSEEN) touched.push_back(v);
+                        distance[v] = candidate;
+                        queue.push({candidate, v});
+                    }
+                }
+            }
+
+            for (uint32_t v : touched) distance[v] = UNSEEN;
+            touched.clear();
+            for (const auto &entry : labels[root]) rootDistance[entry.first] = NO_DISTANCE;
+        }
+
+        // Flatten
+        labelStart.assign(n + 1, 0);
+        hubs.clear();
+        distances.clear();
+        for (uint32_t v = 0; v < n; v++) {
+            for (const auto &entry : labels[v]) {
+                hubs.push_back(entry.first);
+                distances.push_back(entry.second);
+            }
+            labelStart[v + 1] = hubs.size();
+        }
+        return true;
+    }
+
+    // Shortest distance between two node ids (INF if unreachable)
+    long long query(uint32_t s, uint32_t t) const {
+        const uint32_t *a = hubs.data() + labelStart[s];
+        const uint32_t *b = hubs.data() + labelStart[t];
+        const uint32_t *da = distances.data() + labelStart[s];
+        const uint32_t *db = distances.data() + labelStart[t];
+        size_t na = labelStart[s + 1] - labelStart[s];
+        size_t nb = labelStart[t + 1] - labelStart[t];
+        uint64_t best = std::numeric_limits<uint64_t>::max();
+        size_t i = 0, j = 0;
+#if defined(__AVX2__)
+        // Compare a block of eight hubs with all eight rotations of the other label's block, adding
+        // the distances of equal lanes, then advance the block whose largest hub is smaller.
+        // Distances are at most MAX_DISTANCE, so the 32-bit sums cannot overflow.
+        const __m256i rotate = _mm256_setr_epi32(1, 2, 3, 4, 5, 6, 7, 0);
+        const __m256i none = _mm256_set1_epi32(-1);
+        __m256i bestLanes = none;
+        while (i + 8 <= na && j + 8 <= nb) {
+            __m256i va = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+            __m256i vda = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(da + i));
+            __m256i vb = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + j));
+            __m256i vdb = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(db + j));
+            for (int r = 0; r < 8; r++) {
+                __m256i equal = _mm256_cmpeq_epi32(va, vb);
+                __m256i sum = _mm256_blendv_epi8(none, _mm256_add_epi32(vda, vdb), equal);
+                bestLanes = _mm256_min_epu32(bestLanes, sum);
+                vb = _mm256_permutevar8x32_epi32(vb, rotate);
+                vdb = _mm256_permutevar8x32_epi32(vdb, rotate);
+            }
+            uint32_t lastA = a[i + 7], lastB = b[j + 7];
+            if (lastA <= lastB) i += 8;
+            if (lastB <= lastA) j += 8;
+        }
+        alignas(32) uint32_t lanes[8];
+        _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), bestLanes);
+        for (uint32_t lane : lanes) {
+            if (lane != NO_DISTANCE) best = std::min<uint64_t>(best, lane);
+        }
+#endif
+        mergeRange(a, da, i, na, b, db, j, nb, best);
+        return best == std::numeric_limits<uint64_t>::max() ? INF : static_cast<long long>(best);
+    }
+
+    // Answer many queries, split across threads
+    std::vector<long long> batchQuery(const std::vector<std::pair<uint32_t, uint32_t>> &pairs, int numThreads) const {
+        std::vector<long long> results(pairs.size());
+        numThreads = std::max(1, numThreads);
+        std::vector<std::thread> workers;
+        size_t chunk = (pairs.size() + numThreads - 1) / numThreads;
+        for (int t = 0; t < numThreads; t++) {
+            size_t begin = std::min(pairs.size(), t * chunk);
+            size_t end = std::min(pairs.size(), begin + chunk);
+            workers.emplace_back([this, &pairs, &results, begin, end]() {
+                for (size_t q = begin; q < end; q++) {
+                    results[q] = query(pairs[q].first, pairs[q].second);
+                }
+            });
+        }
+        for (auto &worker : workers) {
+            worker.join();
+        }
+        return results;
+    }
+
+    // Average number of hubs per node
+    double averageLabelSize() const {
+        return nodes.empty() ? 0 : static_cast<double>(hubs.size()) / nodes.size();
+    }
+
+    // File: node count, hub count, node names (length-prefixed), label offsets, hubs, distances
+    bool save(const std::string &filename) const {
+        std::ofstream file(filename, std::ios::binary);
+        if (!file) return false;
+        uint64_t counts[2] = {nodes.size(), hubs.size()};
+        file.write(reinterpret_cast<const char*>(counts), sizeof(counts));
+        for (const auto &name : nodes) {
+            uint32_t length = static_cast<uint32_t>(name.size());
+            file.write(reinterpret_cast<const char*>(&length), sizeof(length));
+            file.write(name.data(), length);
+        }
+        file.write(reinterpret_cast<const char*>(labelStart.data()), labelStart.size() * sizeof(uint64_t));
+        file.write(reinterpret_cast<const char*>(hubs.data()), hubs.size() * sizeof(uint32_t));
+        file.write(reinterpret_cast<const char*>(distances.data()), distances.size() * sizeof(uint32_t));
+        return static_cast<bool>(file);
+    }
+
+    // Load a saved index. Every count, offset and hub is checked against the file, so a truncated
+    // or corrupt file fails (leaving the index empty) instead of being queried out of bounds.
+    bool load(const std::string &filename) {
+        if (loadChecked(filename)) return true;
+        nodes.clear();
+        ids.clear();
+        labelStart.clear();
+        hubs.clear();
+        distances.clear();
+        return false;
+    }
+
+private:
+    static constexpr uint32_t NO_DISTANCE = std::numeric_limits<uint32_t>::max();
+
+    std::vector<uint64_t> labelStart;
+    std::vector<uint32_t> hubs;
+    std::vector<uint32_t> distances;
+
+    bool loadChecked(const std::string &filename) {
+        ids.clear();
+        std::ifstream file(filename, std::ios::binary | std::ios::ate);
+        if (!file) return false;
+        uint64_t remaining = static_cast<uint64_t>(file.tellg());
+        file.seekg(0);
+        uint64_t counts[2];
+        if (remaining < sizeof(counts) || !file.read(reinterpret_cast<char*>(counts), sizeof(counts))) return false;
+        remaining -= sizeof(counts);
+        // Each node takes at least a name length and a label offset, each hub a hub and a distance
+        if (counts[0] >= NO_DISTANCE || counts[0] > remaining / (sizeof(uint32_t) + sizeof(uint64_t))) return false;
+        nodes.resize(counts[0]);
+        for (uint32_t v = 0; v < counts[0]; v++) {
+            uint32_t length = 0;
+            if (remaining < sizeof(length) || !file.read(reinterpret_cast<char*>(&length), sizeof(length))) return false;
+            remaining -= sizeof(length);
+            if (length > remaining) return false;
+            nodes[v].resize(length);
+            if (!file.read(&nodes[v][0], length)) return false;
+            remaining -= length;
+            if (!ids.emplace(nodes[v], v).second) return false;
+        }
+        uint64_t offsetBytes = (counts[0] + 1) * sizeof(uint64_t);
+        if (offsetBytes > remaining || counts[1] != (remaining - offsetBytes) / (2 * sizeof(uint32_t))) return false;
+        labelStart.resize(counts[0] + 1);
+        hubs.resize(counts[1]);
+        distances.resize(counts[1]);
+        if (!file.read(reinterpret_cast<char*>(labelStart.data()), offsetBytes) ||
+            !file.read(reinterpret_cast<char*>(hubs.data()), hubs.size() * sizeof(uint32_t)) ||
+            !file.read(reinterpret_cast<char*>(distances.data()), distances.size() * sizeof(uint32_t))) {
+            return false;
+        }
+
+        // Labels are consecutive ranges of sorted hubs that are node ids, with 31-bit distances
+        if (labelStart[0] != 0 || labelStart[counts[0]] != counts[1]) return false;
+        for (uint32_t v = 0; v < counts[0]; v++) {
+            if (labelStart[v] > labelStart[v + 1]) return false;
+        }
+        for (uint32_t v = 0; v < counts[0]; v++) {
+            for (uint64_t i = labelStart[v]; i < labelStart[v + 1]; i++) {
+                if (hubs[i] >= counts[0] || distances[i] > MAX_DISTANCE) return false;
+                if (i > labelStart[v] && hubs[i - 1] >= hubs[i]) return false;
+            }
+        }
+        return true;
+    }
+
+    // Scalar merge of two sorted hub ranges, keeping the best distance through a common hub
+    static void mergeRange(const uint32_t *a, const uint32_t *da, size_t i, size_t endA,
+                           const uint32_t *b, const uint32_t *db, size_t j, size_t endB, uint64_t &best) {
+        // Branch-free steps: hub order is unpredictable, so comparisons would mispredict
+        while (i < endA && j < endB) {
+            uint32_t x = a[i], y = b[j];
+            uint64_t sum = static_cast<uint64_t>(da[i]) + db[j];
+            best = x == y && sum < best ? sum : best;
+            i += x <= y;
+            j += y <= x;
+        }
+    }
+};
+
+// Out-of-class definitions, needed before C++17 because the constants are bound to references
+constexpr uint32_t HubLabels::MAX_DISTANCE;
+constexpr uint32_t HubLabels::NO_DISTANCE;
+
+class Graph {
+public:
+    std::unordered_map<std::string, std::vector<std::pair<std::string, int>>> adjList;
+
+    // Add an edge with a weight between two variables (for an undirected graph)
+    void addEdge(const std::string &var1, const std::string &var2, int weight) {
+        adjList[var1].push_back({var2, weight});
+        adjList[var2].push_back({var1, weight});
+    }
+
+    // Export the graph to a DOT file for Graphviz visualization
+    void exportGraphToDot(const std::string &filename) {
+        std::ofstream dotFile;
+        dotFile.open(filename);
+
+        dotFile << "graph G {\n";
+        for (const auto &node : adjList) {
+            for (const auto &neighbor : node.second) {
+                if (node.first < neighbor.first) { // Avoid double printing edges in undirected graph
+                    dotFile << "  " << node.first << " -- " << neighbor.first << " [label=\"" << neighbor.second << "\"];\n";
+                }
+            }
+        }
+        dotFile << "}\n";
+        dotFile.close();
+
+        std::cout << "Graph exported to " << filename << " successfully." << std::endl;
+    }
+
+    // Build a hub-labeling index over the current graph; fails on negative weights or on
+    // distances too long for the index
+    bool buildHubLabels(HubLabels &labels) {
+        labels = HubLabels();
+        for (const auto &node : adjList) {
+            labels.ids[node.first] = static_cast<uint32_t>(labels.nodes.size());
+            labels.nodes.push_back(node.first);
+        }
+
+        // Flatten the string-keyed adjacency list into a compressed (CSR) layout
+        size_t n = labels.nodes.size();
+        std::vector<size_t> offsets(n + 1, 0);
+        std::vector<uint32_t> targets;
+        std::vector<uint32_t> weights;
+        for (size_t u = 0; u < n; u++) {
+            for (const auto &neighbor : adjList[labels.nodes[u]]) {
+                if (neighbor.second < 0) return false;
+                targets.push_back(labels.ids[neighbor.first]);
+                weights.push_back(static_cast<uint32_t>(neighbor.second));
+            }
+            offsets[u + 1] = targets.size();
+        }
+
+        return labels.build(offsets, targets, weights);
+    }
+};
+
+int main() {
+    Graph graph;
+
+    // Define the relationships (edges between variables) with weights
+    graph.addEdge("x", "y", 4);
+    graph.addEdge("y", "z", 6);
+    graph.addEdge("x", "a", 2);
+    graph.addEdge("a", "b", 5);
+    graph.addEdge("b", "z", 3);
+    graph.addEdge("a", "y", 1);
+
+    // Export the graph to a DOT file for Graphviz visualization
+    std::string dotFilename = "graph_output.dot";
+    graph.exportGraphToDot(dotFilename);
+
+    // Use Graphviz to generate a PNG image of the graph
+    std::string graphImage = "graph_output.png";
+    std::string dotCommand = "dot -Tpng " + dotFilename + " -o " + graphImage;
+    system(dotCommand.c_str());  // Execute the dot command to generate the PNG image
+
+    // Open the PNG image using the default image viewer
+    #if defined(_WIN32) || defined(_WIN64)
+        system(("start " + graphImage).c_str()); // Windows
+    #elif defined(__APPLE__)
+        system(("open " + graphImage).c_str());  // macOS
+    #else
+        system(("xdg-open " + graphImage).c_str());  // Linux
+    #endif
+
+    // Build the index once and keep it on disk
+    HubLabels labels;
+    if (!graph.buildHubLabels(labels)) {
+        std::cout << "Cannot index this graph: weights must be non-negative and distances below 2^31.\n";
+        return 0;
+    }
+    labels.save("hub_labels.bin");
+    std::cout << "Hub labels: " << labels.nodes.size() << " nodes, " << labels.averageLabelSize()
+              << " hubs per node on average" << std::endl;
+
+    // Now ask the user for source and destination
+    std::string source, destination;
+
+    std::cout << "Enter the source variable: ";
+    std::getline(std::cin, source);
+    std::cout << "Enter the destination variable: ";
+    std::getline(std::cin, destination);
+
+    if (labels.ids.find(source) == labels.ids.end() || labels.ids.find(destination) == labels.ids.end()) {
+        std::cout << "Unknown variable.\n";
+        return 0;
+    }
+    long long distance = labels.query(labels.ids[source], labels.ids[destination]);
+    if (distance == INF) {
+        std::cout << "No path found from " << source << " to " << destination << ".\n";
+    } else {
+        std::cout << "Distance from " << source << " to " << destination << ": " << distance << std::endl;
+    }
+
+    return 0;
+}
@@ -0,0 +1,132 @@
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <string>
+#include <chrono>
+#include <random>
+#include <cstdlib>  // For system()
+#include "k_shortest.h"
+
+// Export the graph to a DOT file for Graphviz visualization (each undirected edge once)
+void exportGraphToDot(const KspGraph &graph, const std::string &filename) {
+    std::ofstream dotFile;
+    dotFile.open(filename);
+
+    dotFile << "graph G {\n";
+    for (size_t e = 0; e < graph.edgeCount(); e++) {
+        if (graph.tail[e] < graph.head[e]) {
+            dotFile << "  " << graph.name(graph.tail[e]) << " -- " << graph.name(graph.head[e])
+                    << " [label=\"" << graph.weights[e] << "\"];\n";
+        }
+    }
+    dotFile << "}\n";
+    dotFile.close();
+
+    std::cout << "Graph exported to " << filename << " successfully." << std::endl;
+}
+
+void printPath(const KspGraph &graph, const KPath &path) {
+    std::cout << "  cost " << path.cost << ": ";
+    for (int node : path.nodes) {
+        std::cout << graph.name(node) << " -> ";
+    }
+    std::cout << "END" << std::endl;
+}
+
+// Time to produce the first k paths from corner to corner of a side x side grid with random weights
+template <typename Engine>
+void benchmark(KspGraph &grid, int side, size_t k, const char *label) {
+    auto start = std::chrono::steady_clock::now();
+    Engine engine(grid, grid.find("n0_0"), grid.find("n" + std::to_string(side - 1) + "_" + std::to_string(side - 1)));
+    double setup = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    KPath path;
+    size_t found = 0;
+    long long first = 0, last = 0;
+    while (found < k && engine.next(path)) {
+        if (found == 0) first = path.cost;
+        last = path.cost;
+        found++;
+    }
+    double total = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "  " << label << ": " << found << " paths (cost " << first << " .. " << last << ") in " << total
+              << " ms, of which " << setup << " ms preprocessing" << std::endl;
+}
+
+int main() {
+    KspGraph graph;
+
+    // Define the relationships (edges between variables) with weights
+    graph.addUndirectedEdge("A", "B", 4);
+    graph.addUndirectedEdge("A", "C", 2);
+    graph.addUndirectedEdge("B", "D", 5);
+    graph.addUndirectedEdge("C", "D", 8);
+    graph.addUndirectedEdge("C", "E", 10);
+    graph.addUndirectedEdge("D", "E", 2);
+    graph.addUndirectedEdge("D", "F", 6);
+    graph.addUndirectedEdge("E", "F", 3);
+    graph.build();
+
+    // Export the graph to a DOT file for Graphviz visualization
+    std::string dotFilename = "graph_output.dot";
+    exportGraphToDot(graph, dotFilename);
+
+    // Use Graphviz to generate a PNG image of the graph
+    std::string graphImage = "graph_output.png";
+    std::string dotCommand = "dot -Tpng " + dotFilename + " -o " + graphImage;
+    system(dotCommand.c_str());  // Execute the dot command to generate the PNG image
+
+    // Open the PNG image using the default image viewer
+    #if defined(_WIN32) || defined(_WIN64)
+        system(("start " + graphImage).c_str()); // Windows
+    #elif defined(__APPLE__)
+        system(("open " + graphImage).c_str());  // macOS
+    #else
+        system(("xdg-open " + graphImage).c_str());  // Linux
+    #endif
+
+    // Now ask the user for source, destination and how many paths
+    std::string source, destination, count;
+    std::cout << "Enter the source node: ";
+    std::getline(std::cin, source);
+    std::cout << "Enter the destination node: ";
+    std::getline(std::cin, destination);
+    std::cout << "How many paths: ";
+    std::getline(std::cin, count);
+    size_t k = std::max(1, std::atoi(count.c_str()));
+
+    int from = graph.find(source), to = graph.find(destination);
+    if (from < 0 || to < 0) {
+        std::cout << "No path found from " << source << " to " << destination << ".\n";
+        return 0;
+    }
+
+    KPath path;
+    std::cout << "Shortest simple paths (Yen):\n";
+    YenKShortestPaths yen(graph, from, to);
+    for (size_t i = 0; i < k && yen.next(path); i++) {
+        printPath(graph, path);
+    }
+    std::cout << "Shortest paths with repeated nodes allowed (Eppstein):\n";
+    EppsteinKShortestWalks eppstein(graph, from, to);
+    for (size_t i = 0; i < k && eppstein.next(path); i++) {
+        printPath(graph, path);
+    }
+
+    // Top-100 paths on a large grid, where enumerating all paths would never finish
+    const int side = 300;
+    KspGraph grid;
+    std::mt19937 rng(7);
+    for (int row = 0; row < side; row++) {
+        for (int col = 0; col < side; col++) {
+            std::string here = "n" + std::to_string(row) + "_" + std::to_string(col);
+            if (col + 1 < side) grid.addUndirectedEdge(here, "n" + std::to_string(row) + "_" + std::to_string(col + 1), 1 + rng() % 100);
+            if (row + 1 < side) grid.addUndirectedEdge(here, "n" + std::to_string(row + 1) + "_" + std::to_string(col), 1 + rng() % 100);
+        }
+    }
+    grid.build();
+    std::cout << side * side << "-node grid, corner to corner:\n";
+    benchmark<YenKShortestPaths>(grid, side, 100, "Yen");
+    benchmark<EppsteinKShortestWalks>(grid, side, 100, "Eppstein");
+
+    return 0;
+}
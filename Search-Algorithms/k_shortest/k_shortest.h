@@ -0,0 +1,618 @@
+#ifndef K_SHORTEST_H
+#define K_SHORTEST_H
+
+#include <vector>
+#include <string>
+#include <queue>
+#include <unordered_map>
+#include <unordered_set>
+#include <algorithm>
+#include <functional>
+#include <cstdint>
+#include <limits>
+
+// K shortest paths from one source to one target, produced one at a time in cost order:
+//   YenKShortestPaths         simple paths (no repeated node)
+//   EppsteinKShortestWalks    paths that may repeat nodes and edges
+// Both start from the shortest-path tree towards the target (one reverse Dijkstra), so each
+// further path costs little more than its length instead of a fresh search of the graph.
+// Edge weights must be non-negative.
+
+const long long KSP_INF = std::numeric_limits<long long>::max();
+
+struct KPath {
+    long long cost = 0;
+    std::vector<int> nodes; // Source first, target last
+};
+
+// Directed weighted graph with named nodes, stored as compressed adjacency arrays for the searches
+class KspGraph {
+public:
+    // Id of a node, added if new
+    int node(const std::string &name) {
+        auto it = ids.find(name);
+        if (it != ids.end()) return it->second;
+        int id = static_cast<int>(names.size());
+        names.push_back(name);
+        ids.emplace(name, id);
+        return id;
+    }
+
+    // Id of a node, or -1 if it is not in the graph
+    int find(const std::string &name) const {
+        auto it = ids.find(name);
+        return it == ids.end() ? -1 : it->second;
+    }
+
+    const std::string &name(int node) const {
+        return names[node];
+    }
+
+    size_t nodeCount() const {
+        return names.size();
+    }
+
+    size_t edgeCount() const {
+        return tail.size();
+    }
+
+    void addEdge(const std::string &from, const std::string &to, int weight) {
+        int a = node(from), b = node(to);
+        addEdge(a, b, weight);
+    }
+
+    void addEdge(int from, int to, int weight) {
+        tail.push_back(from);
+        head.push_back(to);
+        weights.push_back(weight);
+        built = false;
+    }
+
+    // An undirected edge is a pair of directed ones
+    void addUndirectedEdge(const std::string &var1, const std::string &var2, int weight) {
+        int a = node(var1), b = node(var2);
+        addEdge(a, b, weight);
+        addEdge(b, a, weight);
+    }
+
+    // Sort the edges into adjacency arrays; done by the searches, and again after new edges
+    void build() {
+        if (built) return;
+        size_t n = names.size(), m = tail.size();
+        std::vector<int> order(m);
+        for (size_t e = 0; e < m; e++) {
+            order[e] = static_cast<int>(e);
+        }
+        std::stable_sort(order.begin(), order.end(), [this](int a, int b) { return tail[a] < tail[b]; });
+        std::vector<int> sortedTail(m), sortedHead(m), sortedWeights(m);
+        for (size_t e = 0; e < m; e++) {
+            sortedTail[e] = tail[order[e]];
+            sortedHead[e] = head[order[e]];
+            sortedWeights[e] = weights[order[e]];
+        }
+        tail.swap(sortedTail);
+        head.swap(sortedHead);
+        weights.swap(sortedWeights);
+
+        outStart.assign(n + 1, 0);
+        inStart.assign(n + 1, 0);
+        for (size_t e = 0; e < m; e++) {
+            outStart[tail[e] + 1]++;
+            inStart[head[e] + 1]++;
+        }
+        for (size_t v = 0; v < n; v++) {
+            outStart[v + 1] += outStart[v];
+            inStart[v + 1] += inStart[v];
+        }
+        inEdges.assign(m, 0);
+        std::vector<int> fill(inStart.begin(), inStart.end() - 1);
+        for (size_t e = 0; e < m; e++) {
+            inEdges[fill[head[e]]++] = static_cast<int>(e);
+        }
+        built = true;
+    }
+
+    // After build(): edges are numbered so that those leaving v are outStart[v] .. outStart[v + 1] - 1,
+    // and inEdges[inStart[v] .. inStart[v + 1] - 1] are the numbers of the edges entering v
+    std::vector<int> tail, head, weights;
+    std::vector<int> outStart, inStart, inEdges;
+
+private:
+    std::vector<std::string> names;
+    std::unordered_map<std::string, int> ids;
+    bool built = false;
+};
+
+// The graph, built; for constructor initializer lists
+inline KspGraph &builtGraph(KspGraph &graph) {
+    graph.build();
+    return graph;
+}
+
+// Shortest paths from every node to one target: distance, and the first edge of that path
+struct ShortestPathTree {
+    std::vector<long long> distance; // KSP_INF if the target is unreachable
+    std::vector<int> next;           // Edge number, -1 at the target and where unreachable
+    std::vector<int> order;          // Reachable nodes in the order Dijkstra settled them, so each
+                                     // comes after the next node on its tree path, even at equal distance
+
+    ShortestPathTree(const KspGraph &graph, int target)
+        : distance(graph.nodeCount(), KSP_INF), next(graph.nodeCount(), -1) {
+        typedef std::pair<long long, int> Entry;
+        std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> pq;
+        distance[target] = 0;
+        pq.push({0, target});
+        while (!pq.empty()) {
+            auto [d, v] = pq.top();
+            pq.pop();
+            if (d > distance[v]) continue;
+            order.push_back(v);
+            for (int i = graph.inStart[v]; i < graph.inStart[v + 1]; i++) {
+                int e = graph.inEdges[i];
+                int u = graph.tail[e];
+                if (d + graph.weights[e] < distance[u]) {
+                    distance[u] = d + graph.weights[e];
+                    next[u] = e;
+                    pq.push({distance[u], u});
+                }
+            }
+        }
+    }
+};
+
+// Yen's algorithm with Lawler's refinement. Each accepted path is branched ("spurred") only from
+// the node where it left its parent onwards, since earlier branch points were tried by the
+// parent. The shortest-path tree gives each branch point a lower bound: its best allowed first
+// edge plus the exact distance on from there. If that edge's tree path avoids the blocked nodes
+// the bound is the answer; otherwise the branch point is queued at its bound and searched only if
+// it comes to the front. The search is an A* on the tree distances that stops at the first node
+// whose tree path is usable. Paths are node sequences: of parallel edges, only the cheapest is used.
+class YenKShortestPaths {
+public:
+    YenKShortestPaths(KspGraph &graph, int source, int target)
+        : graph(builtGraph(graph)), source(source), target(target), tree(graph, target),
+          blockedStamp(graph.nodeCount(), 0), cleanStamp(graph.nodeCount(), 0), dirtyStamp(graph.nodeCount(), 0),
+          searchStamp(graph.nodeCount(), 0), cost(graph.nodeCount(), 0), parent(graph.nodeCount(), -1) {}
+
+    // The next path in cost order; false when there are no more
+    bool next(KPath &path) {
+        if (accepted.empty()) {
+            if (tree.distance[source] == KSP_INF) return false;
+            Path first;
+            first.nodes.push_back(source);
+            first.prefixCost.push_back(0);
+            followTree(first);
+            return accept(std::move(first), path);
+        }
+        for (; spurred < accepted.size(); spurred++) {
+            spurFrom(spurred);
+        }
+        // Different branch points can reach the same path; only its first copy is accepted
+        while (!queue.empty()) {
+            size_t best = queue.top().second;
+            queue.pop();
+            if (!candidates[best].resolved) {
+                resolve(candidates[best]);
+                continue;
+            }
+            Path candidate = materialize(candidates[best]);
+            if (acceptedNodes.count(candidate.nodes)) continue;
+            return accept(std::move(candidate), path);
+        }
+        return false;
+    }
+
+    // Branch points found, and how many needed a search (the rest were answered by the tree or
+    // never reached the front of the queue)
+    size_t branchPoints() const {
+        return branches;
+    }
+
+    size_t spurSearches() const {
+        return searches;
+    }
+
+private:
+    struct Path {
+        std::vector<int> nodes;
+        std::vector<long long> prefixCost; // Cost from the source to nodes[i]
+        size_t deviation = 0;              // Index where it left the path it was spurred from
+    };
+
+    // A path not yet accepted: the first deviation + 1 nodes of an accepted path, the nodes found
+    // by the spur search, then the tree path. Only the spur search's nodes are stored. Until
+    // resolved, only a lower bound on the cost is known.
+    struct Candidate {
+        long long cost;
+        int parent;          // Accepted path
+        uint32_t deviation;
+        uint32_t spurBegin;  // In spurNodes / spurCosts
+        uint32_t spurCount;
+        bool resolved;
+    };
+
+    // Accepted paths as a prefix tree, so the edges to block at a branch point are the children
+    // of the branch point's trie node
+    struct TrieNode {
+        int node;
+        std::vector<int> children; // Trie node indices
+    };
+
+    struct PathHash {
+        size_t operator()(const std::vector<int> &nodes) const {
+            uint64_t h = 1469598103934665603ULL;
+            for (int node : nodes) {
+                h = (h ^ static_cast<uint32_t>(node)) * 1099511628211ULL;
+            }
+            return static_cast<size_t>(h);
+        }
+    };
+
+    typedef std::pair<long long, size_t> Entry; // (cost, index)
+
+    KspGraph &graph;
+    int source, target;
+    ShortestPathTree tree;
+
+    std::vector<Path> accepted;
+    std::unordered_set<std::vector<int>, PathHash> acceptedNodes;
+    std::vector<TrieNode> trie;
+    size_t spurred = 0; // Accepted paths whose spurs are queued
+    std::vector<Candidate> candidates;
+    std::vector<int> spurNodes;
+    std::vector<long long> spurCosts; // From the branch point
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> queue;
+
+    // Spur search state. Stamps avoid clearing per-node arrays between searches.
+    uint32_t pathStamp = 0, spurStamp = 0;
+    std::vector<uint32_t> blockedStamp; // == pathStamp: on the current root path
+    std::vector<uint32_t> cleanStamp;   // == spurStamp: tree path to the target avoids blocked nodes
+    std::vector<uint32_t> dirtyStamp;   // == pathStamp: tree path runs into a blocked node
+    std::vector<uint32_t> searchStamp;  // == spurStamp: cost and parent are set
+    std::vector<long long> cost;
+    std::vector<int> parent;
+    std::vector<Entry> open;
+    size_t branches = 0, searches = 0;
+
+    // Extend a path along the tree from its last node to the target
+    void followTree(Path &path) const {
+        long long total = path.prefixCost.back();
+        for (int v = path.nodes.back(); v != target;) {
+            int e = tree.next[v];
+            total += graph.weights[e];
+            v = graph.head[e];
+            path.nodes.push_back(v);
+            path.prefixCost.push_back(total);
+        }
+    }
+
+    Path materialize(const Candidate &candidate) const {
+        const Path &root = accepted[candidate.parent];
+        Path path;
+        path.deviation = candidate.deviation;
+        path.nodes.assign(root.nodes.begin(), root.nodes.begin() + candidate.deviation + 1);
+        path.prefixCost.assign(root.prefixCost.begin(), root.prefixCost.begin() + candidate.deviation + 1);
+        for (uint32_t j = 0; j < candidate.spurCount; j++) {
+            path.nodes.push_back(spurNodes[candidate.spurBegin + j]);
+            path.prefixCost.push_back(root.prefixCost[candidate.deviation] + spurCosts[candidate.spurBegin + j]);
+        }
+        followTree(path);
+        return path;
+    }
+
+    bool accept(Path &&best, KPath &path) {
+        path.cost = best.prefixCost.back();
+        path.nodes = best.nodes;
+        if (trie.empty()) trie.push_back({source, {}});
+        int at = 0;
+        for (size_t i = 1; i < best.nodes.size(); i++) {
+            int child = childOf(at, best.nodes[i]);
+            if (child < 0) {
+                child = static_cast<int>(trie.size());
+                trie[at].children.push_back(child);
+                trie.push_back({best.nodes[i], {}});
+            }
+            at = child;
+        }
+        acceptedNodes.insert(best.nodes);
+        accepted.push_back(std::move(best));
+        return true;
+    }
+
+    int childOf(int at, int node) const {
+        for (int c : trie[at].children) {
+            if (trie[c].node == node) return c;
+        }
+        return -1;
+    }
+
+    // Whether the tree path from v reaches the target without a blocked node. Nodes found dirty
+    // stay dirty for the rest of this path's spurs, as the blocked set only grows.
+    bool treeClean(int v) {
+        int u = v;
+        while (u != target && cleanStamp[u] != spurStamp) {
+            if (blockedStamp[u] == pathStamp || dirtyStamp[u] == pathStamp) {
+                for (int w = v; w != u; w = graph.head[tree.next[w]]) {
+                    dirtyStamp[w] = pathStamp;
+                }
+                return false;
+            }
+            u = graph.head[tree.next[u]];
+        }
+        for (int w = v; w != u; w = graph.head[tree.next[w]]) {
+            cleanStamp[w] = spurStamp;
+        }
+        return true;
+    }
+
+    // Queue the paths that leave accepted[index] at each node from its deviation point on
+    void spurFrom(size_t index) {
+        pathStamp++;
+        int at = 0;
+        for (size_t i = 0; i < accepted[index].deviation; i++) {
+            blockedStamp[accepted[index].nodes[i]] = pathStamp;
+            at = childOf(at, accepted[index].nodes[i + 1]);
+        }
+        for (size_t i = accepted[index].deviation; i + 1 < accepted[index].nodes.size(); i++) {
+            blockedStamp[accepted[index].nodes[i]] = pathStamp;
+            spurStamp++;
+            branchPoint(index, i, at);
+            at = childOf(at, accepted[index].nodes[i + 1]);
+        }
+    }
+
+    // Whether a first step from a branch point is allowed: not back onto the root path, not where
+    // an accepted path with the same root went (children of trie node `at`), and not a dead end
+    bool allowed(int w, int at) const {
+        if (blockedStamp[w] == pathStamp || tree.distance[w] == KSP_INF) return false;
+        for (int c : trie[at].children) {
+            if (trie[c].node == w) return false;
+        }
+        return true;
+    }
+
+    void addCandidate(long long cost, size_t index, size_t i, uint32_t spurBegin, bool resolved) {
+        candidates.push_back({cost, static_cast<int>(index), static_cast<uint32_t>(i), spurBegin,
+                              static_cast<uint32_t>(spurNodes.size() - spurBegin), resolved});
+        queue.push({cost, candidates.size() - 1});
+    }
+
+    // Queue the branch at nodes[i] of accepted[index], exactly if the tree answers it, otherwise
+    // at its lower bound
+    void branchPoint(size_t index, size_t i, int at) {
+        const Path &path = accepted[index];
+        int spurNode = path.nodes[i];
+        int bestNode = -1;
+        long long bestWeight = 0, bound = KSP_INF;
+        for (int e = graph.outStart[spurNode]; e < graph.outStart[spurNode + 1]; e++) {
+            int w = graph.head[e];
+            if (allowed(w, at) && graph.weights[e] + tree.distance[w] < bound) {
+                bound = graph.weights[e] + tree.distance[w];
+                bestNode = w;
+                bestWeight = graph.weights[e];
+            }
+        }
+        if (bestNode < 0) return;
+        branches++;
+        uint32_t begin = static_cast<uint32_t>(spurNodes.size());
+        if (treeClean(bestNode)) {
+            spurNodes.push_back(bestNode);
+            spurCosts.push_back(bestWeight);
+            addCandidate(path.prefixCost[i] + bound, index, i, begin, true);
+        } else {
+            addCandidate(path.prefixCost[i] + bound, index, i, begin, false);
+        }
+    }
+
+    // Search the branch point of an unresolved candidate and queue it at its exact cost
+    void resolve(const Candidate &candidate) {
+        size_t index = candidate.parent, i = candidate.deviation;
+        const Path &path = accepted[index];
+        pathStamp++;
+        spurStamp++;
+        int at = 0;
+        for (size_t j = 0; j < i; j++) {
+            blockedStamp[path.nodes[j]] = pathStamp;
+            at = childOf(at, path.nodes[j + 1]);
+        }
+        blockedStamp[path.nodes[i]] = pathStamp;
+        spurSearch(index, i, at);
+    }
+
+    void pushOpen(long long f, int node) {
+        open.push_back({f, static_cast<size_t>(node)});
+        std::push_heap(open.begin(), open.end(), std::greater<Entry>());
+    }
+
+    // A* from nodes[i] of accepted[index] to the target, avoiding the nodes before it and the next
+    // nodes of accepted paths sharing its prefix (children of trie node `at`)
+    void spurSearch(size_t index, size_t i, int at) {
+        const Path &path = accepted[index];
+        int spurNode = path.nodes[i];
+        searches++;
+        open.clear();
+        for (int e = graph.outStart[spurNode]; e < graph.outStart[spurNode + 1]; e++) {
+            int w = graph.head[e];
+            if (!allowed(w, at)) continue;
+            if (searchStamp[w] != spurStamp || graph.weights[e] < cost[w]) {
+                searchStamp[w] = spurStamp;
+                cost[w] = graph.weights[e];
+                parent[w] = spurNode;
+                pushOpen(cost[w] + tree.distance[w], w);
+            }
+        }
+
+        while (!open.empty()) {
+            std::pop_heap(open.begin(), open.end(), std::greater<Entry>());
+            auto [f, node] = open.back();
+            open.pop_back();
+            int u = static_cast<int>(node);
+            if (f > cost[u] + tree.distance[u]) continue; // Stale entry
+            // With exact remaining distances, the first node popped whose tree path is usable
+            // completes the cheapest spur
+            if (treeClean(u)) {
+                uint32_t begin = static_cast<uint32_t>(spurNodes.size());
+                for (int v = u; v != spurNode; v = parent[v]) {
+                    spurNodes.push_back(v);
+                    spurCosts.push_back(cost[v]);
+                }
+                std::reverse(spurNodes.begin() + begin, spurNodes.end());
+                std::reverse(spurCosts.begin() + begin, spurCosts.end());
+                addCandidate(path.prefixCost[i] + f, index, i, begin, true);
+                return;
+            }
+            for (int e = graph.outStart[u]; e < graph.outStart[u + 1]; e++) {
+                int w = graph.head[e];
+                if (blockedStamp[w] == pathStamp || tree.distance[w] == KSP_INF) continue;
+                long long g = cost[u] + graph.weights[e];
+                if (searchStamp[w] != spurStamp || g < cost[w]) {
+                    searchStamp[w] = spurStamp;
+                    cost[w] = g;
+                    parent[w] = u;
+                    pushOpen(g + tree.distance[w], w);
+                }
+            }
+        }
+    }
+};
+
+// Eppstein's algorithm: paths may revisit nodes. Any path is the shortest-path tree plus a
+// sequence of "sidetrack" edges off it, each costing weight + distance(head) - distance(tail)
+// extra. Every node gets a persistent heap of the sidetracks reachable along its tree path, and
+// paths are enumerated best-first over those heaps: from a path, replace its last sidetrack by
+// one of the two heap children, or add the best sidetrack after it. Each path after the
+// preprocessing costs O(log k) plus its length.
+class EppsteinKShortestWalks {
+public:
+    EppsteinKShortestWalks(KspGraph &graph, int source, int target)
+        : graph(builtGraph(graph)), source(source), target(target), tree(graph, target),
+          heaps(graph.nodeCount(), -1) {
+        buildHeaps();
+    }
+
+    bool next(KPath &path) {
+        if (tree.distance[source] == KSP_INF) return false;
+        if (!started) {
+            started = true;
+            if (heaps[source] >= 0) {
+                records.push_back({heaps[source], -1});
+                open.push({tree.distance[source] + pool[heaps[source]].delta, 0});
+            }
+            buildPath(-1, tree.distance[source], path);
+            return true;
+        }
+        if (open.empty()) return false;
+        auto [total, r] = open.top();
+        open.pop();
+        const HeapNode &h = pool[records[r].heapNode];
+        int prev = records[r].prev;
+        // Replace the last sidetrack by the next best ones in the same heap
+        for (int child : {h.left, h.right}) {
+            if (child >= 0) {
+                records.push_back({child, prev});
+                open.push({total - h.delta + pool[child].delta, static_cast<int>(records.size() - 1)});
+            }
+        }
+        // Or keep it and add the best sidetrack after it
+        int after = heaps[graph.head[h.edge]];
+        if (after >= 0) {
+            records.push_back({after, r});
+            open.push({total + pool[after].delta, static_cast<int>(records.size() - 1)});
+        }
+        buildPath(r, total, path);
+        return true;
+    }
+
+    // Heap nodes allocated, including the copies made by persistence
+    size_t heapNodes() const {
+        return pool.size();
+    }
+
+private:
+    // Leftist heap node; heaps share structure and are never modified once built
+    struct HeapNode {
+        long long delta; // Extra cost of the sidetrack
+        int edge;
+        int rank;
+        int left, right;
+    };
+
+    // A sidetrack sequence: the heap node of the last one, and the record of the ones before it
+    struct Record {
+        int heapNode;
+        int prev;
+    };
+
+    KspGraph &graph;
+    int source, target;
+    ShortestPathTree tree;
+    std::vector<HeapNode> pool;
+    std::vector<int> heaps; // Root of each node's heap, -1 if empty
+    std::vector<Record> records;
+    typedef std::pair<long long, int> Entry; // (path cost, record)
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> open;
+    bool started = false;
+
+    int rank(int h) const {
+        return h < 0 ? 0 : pool[h].rank;
+    }
+
+    // Merge two heaps. Nodes numbered from `privateFrom` on belong to the heap being built and
+    // are modified in place; older nodes are shared, and are copied on the merge path instead.
+    int merge(int a, int b, int privateFrom) {
+        if (a < 0) return b;
+        if (b < 0) return a;
+        if (pool[b].delta < pool[a].delta) std::swap(a, b);
+        if (a < privateFrom) {
+            HeapNode copy = pool[a];
+            pool.push_back(copy);
+            a = static_cast<int>(pool.size() - 1);
+        }
+        int right = merge(pool[a].right, b, privateFrom);
+        pool[a].right = right;
+        if (rank(pool[a].left) < rank(pool[a].right)) std::swap(pool[a].left, pool[a].right);
+        pool[a].rank = rank(pool[a].right) + 1;
+        return a;
+    }
+
+    // Nodes in the order the tree was built, so the heap of the next node on the tree path is ready
+    // first. A node's own sidetracks form a new heap, merged into the shared one of the next node.
+    void buildHeaps() {
+        for (int v : tree.order) {
+            int privateFrom = static_cast<int>(pool.size());
+            int own = -1;
+            for (int e = graph.outStart[v]; e < graph.outStart[v + 1]; e++) {
+                int w = graph.head[e];
+                if (e == tree.next[v] || tree.distance[w] == KSP_INF) continue;
+                pool.push_back({graph.weights[e] + tree.distance[w] - tree.distance[v], e, 1, -1, -1});
+                own = merge(own, static_cast<int>(pool.size() - 1), privateFrom);
+            }
+            int inherited = v == target ? -1 : heaps[graph.head[tree.next[v]]];
+            heaps[v] = merge(own, inherited, privateFrom);
+        }
+    }
+
+    // Tree path from the source, taking the sidetracks of record r in order
+    void buildPath(int r, long long total, KPath &path) {
+        std::vector<int> sidetracks;
+        for (; r >= 0; r = records[r].prev) {
+            sidetracks.push_back(pool[records[r].heapNode].edge);
+        }
+        std::reverse(sidetracks.begin(), sidetracks.end());
+        path.cost = total;
+        path.nodes.assign(1, source);
+        int v = source;
+        for (int e : sidetracks) {
+            for (; v != graph.tail[e]; v = graph.head[tree.next[v]]) {
+                path.nodes.push_back(graph.head[tree.next[v]]);
+            }
+            v = graph.head[e];
+            path.nodes.push_back(v);
+        }
+        for (; v != target; v = graph.head[tree.next[v]]) {
+            path.nodes.push_back(graph.head[tree.next[v]]);
+        }
+    }
+};
+
+#endif
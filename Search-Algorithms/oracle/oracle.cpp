@@ -5,8 +5,186 @@
 #include <set>
 #include <algorithm>
 #include <queue>
+#include <string>
+#include <thread>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
 #include <cstdlib>  // For system()
 #include <limits>   // For std::numeric_limits
+#include "../dot_io/dot_io.h"
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+const uint32_t NO_HOP = std::numeric_limits<uint32_t>::max();
+
+// Routing table file layout:
+//   OracleHeader
+//   uint64_t rowStart[nodeCount + 1]     first interval of each node's row
+//   uint32_t intervalFirst[intervalCount] first destination of each interval
+//   uint32_t intervalHop[intervalCount]   next hop toward every destination in the interval
+//   uint64_t nameStart[nodeCount + 1]    node names, concatenated
+//   char names[nameBytes]
+struct OracleHeader {
+    char magic[8];
+    uint32_t nodeCount;
+    uint32_t reserved = 0;
+    uint64_t intervalCount;
+    uint64_t nameBytes;
+};
+
+const char ORACLE_MAGIC[8] = {'O', 'R', 'A', 'C', 'L', 'E', '1', '\0'};
+
+// Read-only view of a routing table file, memory-mapped so that queries touch only the rows they
+// need. A route is found by looking up the next hop toward the destination (a binary search in
+// one row's intervals) at each node along the way: O(path length) lookups, no search.
+class RoutingOracle {
+public:
+    RoutingOracle() {}
+    ~RoutingOracle() { close(); }
+
+    RoutingOracle(const RoutingOracle &) = delete;
+    RoutingOracle &operator=(const RoutingOracle &) = delete;
+
+    bool open(const std::string &filename) {
+        close();
+#if defined(__linux__)
+        int fd = ::open(filename.c_str(), O_RDONLY);
+        if (fd < 0) return false;
+        struct stat info;
+        if (fstat(fd, &info) != 0 || static_cast<size_t>(info.st_size) < sizeof(OracleHeader)) {
+            ::close(fd);
+            return false;
+        }
+        size = static_cast<size_t>(info.st_size);
+        void *memory = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+        ::close(fd);
+        if (memory == MAP_FAILED) return false;
+        base = static_cast<const char*>(memory);
+        mapped = true;
+#else
+        std::ifstream file(filename, std::ios::binary);
+        if (!file) return false;
+        buffer.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+        if (buffer.size() < sizeof(OracleHeader)) return false;
+        base = buffer.data();
+        size = buffer.size();
+#endif
+        std::memcpy(&header, base, sizeof(header));
+        if (std::memcmp(header.magic, ORACLE_MAGIC, sizeof(header.magic)) != 0) {
+            close();
+            return false;
+        }
+        // The tables the header describes must lie inside the file, with every row non-empty,
+        // every offset inside its table, and every row's intervals starting at destination 0,
+        // strictly increasing and pointing at real nodes (or NO_HOP)
+        uint64_t rest = size - sizeof(OracleHeader);
+        uint64_t offsetBytes = (static_cast<uint64_t>(header.nodeCount) + 1) * sizeof(uint64_t);
+        if (rest < 2 * offsetBytes || header.intervalCount > (rest - 2 * offsetBytes) / (2 * sizeof(uint32_t)) ||
+            header.nameBytes > rest - 2 * offsetBytes - header.intervalCount * 2 * sizeof(uint32_t)) {
+            close();
+            return false;
+        }
+        const char *p = base + sizeof(OracleHeader);
+        uint64_t intervalBytes = header.intervalCount * 2 * sizeof(uint32_t);
+        const uint64_t *rows = reinterpret_cast<const uint64_t*>(p);
+        const uint64_t *nameOffsets = reinterpret_cast<const uint64_t*>(p + offsetBytes + intervalBytes);
+        bool valid = rows[0] == 0 && rows[header.nodeCount] == header.intervalCount &&
+                     nameOffsets[0] == 0 && nameOffsets[header.nodeCount] <= header.nameBytes;
+        for (uint32_t v = 0; valid && v < header.nodeCount; v++) {
+            valid = rows[v] < rows[v + 1] && nameOffsets[v] <= nameOffsets[v + 1];
+        }
+        const uint32_t *firsts = reinterpret_cast<const uint32_t*>(p + offsetBytes);
+        const uint32_t *hops = firsts + header.intervalCount;
+        for (uint32_t v = 0; valid && v < header.nodeCount; v++) {
+            valid = firsts[rows[v]] == 0;
+            for (uint64_t i = rows[v]; valid && i < rows[v + 1]; i++) {
+                valid = (i == rows[v] || firsts[i - 1] < firsts[i]) && (hops[i] < header.nodeCount || hops[i] == NO_HOP);
+            }
+        }
+        if (!valid) {
+            close();
+            return false;
+        }
+        rowStart = rows;
+        p += offsetBytes;
+        intervalFirst = reinterpret_cast<const uint32_t*>(p);
+        p += header.intervalCount * sizeof(uint32_t);
+        intervalHop = reinterpret_cast<const uint32_t*>(p);
+        p += header.intervalCount * sizeof(uint32_t);
+        nameStart = nameOffsets;
+        names = p + offsetBytes;
+        for (uint32_t v = 0; v < header.nodeCount; v++) {
+            ids[name(v)] = v;
+        }
+        return true;
+    }
+
+    void close() {
+#if defined(__linux__)
+        if (mapped) munmap(const_cast<char*>(base), size);
+#endif
+        mapped = false;
+        base = nullptr;
+        ids.clear();
+    }
+
+    bool isOpen() const {
+        return base != nullptr;
+    }
+
+    // Next node on a shortest path from `from` to `to`; NO_HOP if `to` is unreachable
+    uint32_t nextHop(uint32_t from, uint32_t to) const {
+        const uint32_t *first = intervalFirst + rowStart[from];
+        const uint32_t *last = intervalFirst + rowStart[from + 1];
+        size_t interval = std::upper_bound(first, last, to) - intervalFirst - 1;
+        return intervalHop[interval];
+    }
+
+    // Node names along a shortest path, empty if there is none. A shortest path visits every node
+    // at most once, so a route longer than that means the tables loop and there is no answer.
+    std::vector<std::string> route(const std::string &source, const std::string &destination) const {
+        auto from = ids.find(source);
+        auto to = ids.find(destination);
+        if (from == ids.end() || to == ids.end()) return {};
+        std::vector<std::string> path = {source};
+        for (uint32_t v = from->second; v != to->second;) {
+            if (path.size() > header.nodeCount) return {};
+            v = nextHop(v, to->second);
+            if (v == NO_HOP) return {};
+            path.push_back(name(v));
+        }
+        return path;
+    }
+
+    std::string name(uint32_t v) const {
+        return std::string(names + nameStart[v], nameStart[v + 1] - nameStart[v]);
+    }
+
+    uint32_t nodeCount() const { return header.nodeCount; }
+    uint64_t intervalCount() const { return header.intervalCount; }
+    size_t fileBytes() const { return size; }
+
+private:
+    OracleHeader header{};
+    const char *base = nullptr;
+    size_t size = 0;
+    bool mapped = false;
+    const uint64_t *rowStart = nullptr;
+    const uint32_t *intervalFirst = nullptr;
+    const uint32_t *intervalHop = nullptr;
+    const uint64_t *nameStart = nullptr;
+    const char *names = nullptr;
+    std::unordered_map<std::string, uint32_t> ids;
+#if !defined(__linux__)
+    std::vector<char> buffer;
+#endif
+};
 
 class Graph {
 public:
@@ -16,6 +194,7 @@ public:
     void addEdge(const std::string &var1, const std::string &var2) {
         adjList[var1].push_back(var2);
         adjList[var2].push_back(var1);
+        routes.close(); // The routing tables are out of date
     }
 
     // Display the graph in the terminal (ASCII representation)
@@ -32,78 +211,167 @@ public:
         std::cout << "----------------------------------\n";
     }
 
-    // Export the graph to a DOT file for Graphviz visualization
+    // Export the graph to a DOT file for Graphviz visualization (each undirected edge once)
     void exportGraphToDot(const std::string &filename) {
-        std::ofstream dotFile;
-        dotFile.open(filename);
-
-        dotFile << "graph G {\n";
-        for (const auto &node : adjList) {
-            for (const auto &neighbor : node.second) {
-                dotFile << "  " << node.first << " -- " << neighbor << ";\n";
-            }
+        if (writeUndirectedDot(adjList, filename) < 0) {
+            std::cout << "Could not write " << filename << "." << std::endl;
+            return;
         }
-        dotFile << "}\n";
-        dotFile.close();
-
         std::cout << "Graph exported to " << filename << " successfully." << std::endl;
     }
 
-    // Heuristic function for Oracle (simple lexicographical heuristic)
-    double heuristic(const std::string &node, const std::string &goal) {
-        return std::abs(static_cast<int>(node[0]) - static_cast<int>(goal[0]));
-    }
+    // Precompute, for every node, the next hop toward every destination and write the tables to
+    // `filename` (see RoutingOracle).
+    //
+    // Nodes are first renumbered in Cuthill-McKee order (breadth-first, lower degree first), so
+    // nodes close in the graph get close numbers. Then one breadth-first search per source, spread
+    // over threads, finds the first step of a shortest path to every destination. Destinations in
+    // that order that share a first step form long runs, so each row is stored as intervals
+    // (first destination, next hop) instead of one entry per destination.
+    bool buildOracle(const std::string &filename, int numThreads) {
+        // Locality-preserving order, starting from the lowest-degree node of each component
+        std::vector<std::string> names;
+        for (const auto &node : adjList) names.push_back(node.first);
+        std::sort(names.begin(), names.end());
+        std::unordered_map<std::string, uint32_t> nameIndex;
+        for (uint32_t i = 0; i < names.size(); i++) nameIndex[names[i]] = i;
+        auto degree = [&](uint32_t i) { return adjList[names[i]].size(); };
 
-    // Oracle algorithm to find a path from source to destination
-    void oracle(const std::string &source, const std::string &destination) {
-        std::priority_queue<std::pair<double, std::vector<std::string>>> openSet; // Min-heap for exploring nodes
-        std::set<std::string> closedSet;  // To keep track of visited nodes
-        openSet.push({0.0, {source}}); // Start with the initial path from the source
-
-        std::cout << "Starting Oracle Search from " << source << " to " << destination << "...\n";
-
-        while (!openSet.empty()) {
-            // Get the path with the lowest cost
-            auto current = openSet.top();
-            openSet.pop();
-            std::vector<std::string> path = current.second;
-            std::string currentNode = path.back();
-
-            // If we reach the destination, print the path
-            if (currentNode == destination) {
-                std::cout << "Path found: ";
-                for (const auto &node : path) {
-                    std::cout << node << " -> ";
+        std::vector<uint32_t> order;
+        std::vector<uint32_t> position(names.size(), NO_HOP);
+        std::vector<uint32_t> starts(names.size());
+        for (uint32_t i = 0; i < names.size(); i++) starts[i] = i;
+        std::stable_sort(starts.begin(), starts.end(), [&](uint32_t a, uint32_t b) { return degree(a) < degree(b); });
+        for (uint32_t start : starts) {
+            if (position[start] != NO_HOP) continue;
+            position[start] = static_cast<uint32_t>(order.size());
+            order.push_back(start);
+            for (size_t head = order.size() - 1; head < order.size(); head++) {
+                std::vector<uint32_t> next;
+                for (const auto &neighbor : adjList[names[order[head]]]) {
+                    uint32_t id = nameIndex[neighbor];
+                    if (position[id] == NO_HOP) {
+                        position[id] = 0; // Seen; numbered below
+                        next.push_back(id);
+                    }
+                }
+                std::stable_sort(next.begin(), next.end(), [&](uint32_t a, uint32_t b) { return degree(a) < degree(b); });
+                for (uint32_t id : next) {
+                    position[id] = static_cast<uint32_t>(order.size());
+                    order.push_back(id);
                 }
-                std::cout << "END" << std::endl;
-                return;
             }
+        }
 
-            // Mark the current node as visited
-            closedSet.insert(currentNode);
+        // Adjacency in CSR form over the new numbering
+        uint32_t n = static_cast<uint32_t>(order.size());
+        std::vector<uint32_t> offsets(n + 1, 0);
+        std::vector<uint32_t> targets;
+        for (uint32_t v = 0; v < n; v++) {
+            for (const auto &neighbor : adjList[names[order[v]]]) {
+                targets.push_back(position[nameIndex[neighbor]]);
+            }
+            offsets[v + 1] = static_cast<uint32_t>(targets.size());
+        }
 
-            // Explore the neighbors
-            for (const auto &neighbor : adjList[currentNode]) {
-                if (closedSet.find(neighbor) != closedSet.end()) {
-                    continue; // Ignore already visited nodes
+        // One BFS per source; sources are handed out through a shared counter
+        std::vector<std::vector<uint32_t>> rowFirst(n), rowHop(n);
+        std::atomic<uint32_t> nextSource{0};
+        std::vector<std::thread> workers;
+        for (int t = 0; t < std::max(1, numThreads); t++) {
+            workers.emplace_back([&]() {
+                std::vector<uint32_t> hop(n);
+                std::vector<uint32_t> queue(n);
+                for (uint32_t source; (source = nextSource.fetch_add(1)) < n;) {
+                    std::fill(hop.begin(), hop.end(), NO_HOP);
+                    hop[source] = source;
+                    size_t head = 0, tail = 0;
+                    for (uint32_t e = offsets[source]; e < offsets[source + 1]; e++) {
+                        if (hop[targets[e]] == NO_HOP) {
+                            hop[targets[e]] = targets[e];
+                            queue[tail++] = targets[e];
+                        }
+                    }
+                    while (head < tail) {
+                        uint32_t v = queue[head++];
+                        for (uint32_t e = offsets[v]; e < offsets[v + 1]; e++) {
+                            if (hop[targets[e]] == NO_HOP) {
+                                hop[targets[e]] = hop[v]; // Same first step as the node it was reached from
+                                queue[tail++] = targets[e];
+                            }
+                        }
+                    }
+                    for (uint32_t destination = 0; destination < n; destination++) {
+                        if (destination == 0 || hop[destination] != hop[destination - 1]) {
+                            rowFirst[source].push_back(destination);
+                            rowHop[source].push_back(hop[destination]);
+                        }
+                    }
                 }
+            });
+        }
+        for (auto &worker : workers) {
+            worker.join();
+        }
 
-                // Create a new path for this neighbor
-                std::vector<std::string> newPath = path;
-                newPath.push_back(neighbor);
+        // File: header, row offsets, interval starts, interval hops, node names
+        std::ofstream file(filename, std::ios::binary);
+        if (!file) return false;
+        std::vector<uint64_t> rowStart(n + 1, 0);
+        for (uint32_t v = 0; v < n; v++) rowStart[v + 1] = rowStart[v] + rowFirst[v].size();
+        std::vector<uint64_t> nameStart(n + 1, 0);
+        for (uint32_t v = 0; v < n; v++) nameStart[v + 1] = nameStart[v] + names[order[v]].size();
 
-                // Calculate costs
-                double gCost = newPath.size(); // g(n) is the number of steps from the source
-                double hCost = heuristic(neighbor, destination); // h(n) is the heuristic
-                double fCost = gCost + hCost; // f(n) = g(n) + h(n)
+        OracleHeader header;
+        std::memcpy(header.magic, ORACLE_MAGIC, sizeof(header.magic));
+        header.nodeCount = n;
+        header.intervalCount = rowStart[n];
+        header.nameBytes = nameStart[n];
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        file.write(reinterpret_cast<const char*>(rowStart.data()), rowStart.size() * sizeof(uint64_t));
+        for (uint32_t v = 0; v < n; v++) {
+            file.write(reinterpret_cast<const char*>(rowFirst[v].data()), rowFirst[v].size() * sizeof(uint32_t));
+        }
+        for (uint32_t v = 0; v < n; v++) {
+            file.write(reinterpret_cast<const char*>(rowHop[v].data()), rowHop[v].size() * sizeof(uint32_t));
+        }
+        file.write(reinterpret_cast<const char*>(nameStart.data()), nameStart.size() * sizeof(uint64_t));
+        for (uint32_t v = 0; v < n; v++) {
+            file.write(names[order[v]].data(), names[order[v]].size());
+        }
+        return static_cast<bool>(file);
+    }
 
-                // Push the new path into the open set with the cost
-                openSet.push({-fCost, newPath}); // Use negative because std::priority_queue is a max-heap
+    // Oracle query: route from source to destination by following precomputed next hops.
+    // The tables are built (and written to oracleFile) on first use after the graph changes.
+    void oracle(const std::string &source, const std::string &destination) {
+        std::cout << "Starting Oracle Search from " << source << " to " << destination << "...\n";
+
+        if (!routes.isOpen()) {
+            int numThreads = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+            if (!buildOracle(oracleFile, numThreads) || !routes.open(oracleFile)) {
+                std::cout << "Could not build the routing tables in " << oracleFile << ".\n";
+                return;
             }
+            std::cout << "Routing tables: " << routes.nodeCount() << " nodes, " << routes.intervalCount()
+                      << " intervals (" << routes.fileBytes() << " bytes)\n";
         }
 
-        std::cout << "No path found from " << source << " to " << destination << ".\n";
+        std::vector<std::string> path = routes.route(source, destination);
+        if (path.empty()) {
+            std::cout << "No path found from " << source << " to " << destination << ".\n";
+            return;
+        }
+        std::cout << "Path found: ";
+        for (const auto &node : path) {
+            std::cout << node << " -> ";
+        }
+        std::cout << "END" << std::endl;
     }
+
+private:
+    std::string oracleFile = "oracle_routes.bin";
+    RoutingOracle routes;
 };
 
 int main() {
@@ -0,0 +1,455 @@
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <array>
+#include <string>
+#include <atomic>
+#include <thread>
+#include <chrono>
+#include <random>
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <cstdint>
+#include <cstdlib>  // For std::abs
+#include <cstring>
+#include <limits>   // For std::numeric_limits
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+// The 15-puzzle: tiles 1..15 and a blank (0) on a 4x4 board; the goal has the blank in cell 0
+// and tile t in cell t
+const int SIDE = 4;
+const int CELLS = SIDE * SIDE;
+
+// Cells next to each cell
+std::vector<std::vector<int>> buildNeighbours() {
+    std::vector<std::vector<int>> neighbours(CELLS);
+    for (int cell = 0; cell < CELLS; cell++) {
+        int row = cell / SIDE, col = cell % SIDE;
+        if (row > 0) neighbours[cell].push_back(cell - SIDE);
+        if (row < SIDE - 1) neighbours[cell].push_back(cell + SIDE);
+        if (col > 0) neighbours[cell].push_back(cell - 1);
+        if (col < SIDE - 1) neighbours[cell].push_back(cell + 1);
+    }
+    return neighbours;
+}
+
+const std::vector<std::vector<int>> NEIGHBOURS = buildNeighbours();
+
+// Perfect hash of k distinct cells (a partial permutation of the 16 cells) to [0, 16!/(16-k)!).
+// Each cell is numbered among the cells not used before it, so the ranks are dense.
+uint64_t rankCells(const uint8_t *cells, int k) {
+    uint32_t used = 0;
+    uint64_t rank = 0;
+    for (int i = 0; i < k; i++) {
+        uint32_t below = used & ((1u << cells[i]) - 1);
+        rank = rank * (CELLS - i) + (cells[i] - __builtin_popcount(below));
+        used |= 1u << cells[i];
+    }
+    return rank;
+}
+
+void unrankCells(uint64_t rank, int k, uint8_t *cells) {
+    uint8_t digits[CELLS];
+    for (int i = k - 1; i >= 0; i--) {
+        digits[i] = static_cast<uint8_t>(rank % (CELLS - i));
+        rank /= CELLS - i;
+    }
+    uint32_t used = 0;
+    for (int i = 0; i < k; i++) {
+        // The digits[i]-th free cell
+        int cell = 0;
+        for (int free = digits[i]; ; cell++) {
+            if (used & (1u << cell)) continue;
+            if (free-- == 0) break;
+        }
+        cells[i] = static_cast<uint8_t>(cell);
+        used |= 1u << cell;
+    }
+}
+
+uint64_t permutationCount(int k) {
+    uint64_t count = 1;
+    for (int i = 0; i < k; i++) count *= CELLS - i;
+    return count;
+}
+
+// Split [0, n) into one contiguous range per thread; ranges start on even indices so that no two
+// threads write the same byte of a 4-bit array
+void parallelFor(uint64_t n, int numThreads, const std::function<void(uint64_t, uint64_t, int)> &fn) {
+    std::vector<std::thread> workers;
+    uint64_t chunk = ((n + numThreads - 1) / numThreads + 1) & ~uint64_t(1);
+    for (int t = 0; t < numThreads; t++) {
+        uint64_t begin = std::min(n, t * chunk);
+        uint64_t end = std::min(n, begin + chunk);
+        workers.emplace_back([&fn, begin, end, t]() {
+            fn(begin, end, t);
+        });
+    }
+    for (auto &worker : workers) {
+        worker.join();
+    }
+}
+
+// A pattern database: for every placement of a subset of the tiles (the pattern), the fewest
+// moves needed to bring those tiles home, ignoring all other tiles.
+//
+// It is built by a parallel breadth-first search backwards from the goal over abstract states
+// (pattern tile cells plus the blank cell), one level at a time, with threads claiming states by
+// CAS on a shared distance array. In an additive database only moves of pattern tiles count, so
+// databases over disjoint patterns can be summed; blank moves past other tiles cost nothing and
+// are closed over within a level. Otherwise every move counts, and databases can only be maxed.
+//
+// The result keeps the minimum over blank cells, indexed by rankCells() of the pattern tile cells
+// and packed two entries per byte (4 bits, saturating at 15, which keeps it admissible).
+class PatternDatabase {
+public:
+    std::vector<int> tiles;
+    bool additive;
+
+    PatternDatabase(const std::vector<int> &tiles, bool additive) : tiles(tiles), additive(additive) {}
+
+    ~PatternDatabase() {
+        release();
+    }
+
+    PatternDatabase(const PatternDatabase &) = delete;
+    PatternDatabase &operator=(const PatternDatabase &) = delete;
+
+    void build(int numThreads) {
+        release();
+        int k = static_cast<int>(tiles.size());
+        uint64_t stateCount = permutationCount(k + 1);
+        std::vector<std::atomic<uint8_t>> distance(stateCount);
+        for (auto &d : distance) d.store(UNSEEN, std::memory_order_relaxed);
+
+        // Goal: every pattern tile on its own cell, blank on cell 0
+        uint8_t goal[CELLS];
+        for (int i = 0; i < k; i++) goal[i] = static_cast<uint8_t>(tiles[i]);
+        goal[k] = 0;
+        uint64_t goalRank = rankCells(goal, k + 1);
+        distance[goalRank].store(0);
+
+        std::vector<uint64_t> level = {goalRank};
+        for (int depth = 0; !level.empty(); depth++) {
+            // Blank moves that cost nothing stay on this level
+            std::vector<uint64_t> frontier = level;
+            while (additive && !frontier.empty()) {
+                frontier = expand(frontier, distance, depth, false, numThreads);
+                level.insert(level.end(), frontier.begin(), frontier.end());
+            }
+            level = expand(level, distance, depth + 1, true, numThreads);
+        }
+
+        // Minimum over the blank's cell for every placement of the pattern tiles
+        entries = permutationCount(k);
+        owned.assign((entries + 1) / 2, 0);
+        parallelFor(entries, numThreads, [&](uint64_t begin, uint64_t end, int) {
+            uint8_t cells[CELLS];
+            for (uint64_t rank = begin; rank < end; rank++) {
+                unrankCells(rank, k, cells);
+                uint32_t used = 0;
+                for (int i = 0; i < k; i++) used |= 1u << cells[i];
+                int best = UNSEEN;
+                for (int blank = 0; blank < CELLS; blank++) {
+                    if (used & (1u << blank)) continue;
+                    cells[k] = static_cast<uint8_t>(blank);
+                    best = std::min<int>(best, distance[rankCells(cells, k + 1)].load(std::memory_order_relaxed));
+                }
+                int value = std::min(best, 15);
+                owned[rank / 2] |= static_cast<uint8_t>(rank % 2 ? value << 4 : value);
+            }
+        });
+        packed = owned.data();
+    }
+
+    // File: magic, flags (bit 0: additive), tile count, tiles, then the packed entries
+    bool save(const std::string &path) const {
+        std::ofstream out(path, std::ios::binary);
+        if (!out || !packed) return false;
+        uint32_t header[3] = {MAGIC, additive ? 1u : 0u, static_cast<uint32_t>(tiles.size())};
+        out.write(reinterpret_cast<const char*>(header), sizeof(header));
+        for (int tile : tiles) {
+            uint32_t value = static_cast<uint32_t>(tile);
+            out.write(reinterpret_cast<const char*>(&value), sizeof(value));
+        }
+        out.write(reinterpret_cast<const char*>(packed), (entries + 1) / 2);
+        return static_cast<bool>(out);
+    }
+
+    // Map a saved database; false if the file is missing or built for another pattern
+    bool load(const std::string &path) {
+        release();
+#if defined(__linux__)
+        int fd = open(path.c_str(), O_RDONLY);
+        if (fd < 0) return false;
+        struct stat info;
+        if (fstat(fd, &info) != 0) {
+            close(fd);
+            return false;
+        }
+        mappedSize = static_cast<size_t>(info.st_size);
+        void *memory = mappedSize ? mmap(nullptr, mappedSize, PROT_READ, MAP_SHARED, fd, 0) : MAP_FAILED;
+        close(fd);
+        if (memory == MAP_FAILED) return false;
+        mapped = static_cast<const uint8_t*>(memory);
+        const uint8_t *data = mapped;
+        size_t size = mappedSize;
+#else
+        std::ifstream in(path, std::ios::binary);
+        if (!in) return false;
+        owned.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+        const uint8_t *data = owned.data();
+        size_t size = owned.size();
+#endif
+        size_t headerSize = (3 + tiles.size()) * sizeof(uint32_t);
+        entries = permutationCount(static_cast<int>(tiles.size()));
+        bool valid = size == headerSize + (entries + 1) / 2;
+        if (valid) {
+            uint32_t header[3];
+            std::memcpy(header, data, sizeof(header));
+            valid = header[0] == MAGIC && header[1] == (additive ? 1u : 0u) && header[2] == tiles.size();
+            for (size_t i = 0; valid && i < tiles.size(); i++) {
+                uint32_t tile;
+                std::memcpy(&tile, data + (3 + i) * sizeof(uint32_t), sizeof(tile));
+                valid = tile == static_cast<uint32_t>(tiles[i]);
+            }
+        }
+        if (!valid) {
+            release();
+            return false;
+        }
+        packed = data + headerSize;
+        return true;
+    }
+
+    // Heuristic value given the cell of every tile
+    int lookup(const uint8_t *cellOfTile) const {
+        uint8_t cells[CELLS];
+        for (size_t i = 0; i < tiles.size(); i++) cells[i] = cellOfTile[tiles[i]];
+        uint64_t rank = rankCells(cells, static_cast<int>(tiles.size()));
+        uint8_t pair = packed[rank / 2];
+        return rank % 2 ? pair >> 4 : pair & 0xF;
+    }
+
+    size_t sizeBytes() const {
+        return (entries + 1) / 2;
+    }
+
+private:
+    static const uint8_t UNSEEN = 0xFF;
+    static const uint32_t MAGIC = 0x31424450; // "PDB1"
+
+    uint64_t entries = 0;
+    std::vector<uint8_t> owned;
+    const uint8_t *packed = nullptr;
+    const uint8_t *mapped = nullptr;
+    size_t mappedSize = 0;
+
+    void release() {
+#if defined(__linux__)
+        if (mapped) munmap(const_cast<uint8_t*>(mapped), mappedSize);
+#endif
+        mapped = nullptr;
+        packed = nullptr;
+        owned.clear();
+    }
+
+    // Successors of `states` through pattern-tile moves (costly) or blank-only moves (free),
+    // claimed at `depth`
+    std::vector<uint64_t> expand(const std::vector<uint64_t> &states, std::vector<std::atomic<uint8_t>> &distance,
+                                 int depth, bool costly, int numThreads) const {
+        int k = static_cast<int>(tiles.size());
+        std::vector<std::vector<uint64_t>> found(numThreads);
+        parallelFor(states.size(), numThreads, [&](uint64_t begin, uint64_t end, int t) {
+            uint8_t cells[CELLS];
+            for (uint64_t s = begin; s < end; s++) {
+                unrankCells(states[s], k + 1, cells);
+                int blank = cells[k];
+                for (int next : NEIGHBOURS[blank]) {
+                    int tile = -1;
+                    for (int i = 0; i < k; i++) {
+                        if (cells[i] == next) tile = i;
+                    }
+                    // Without additivity every move costs one
+                    bool moveCosts = tile >= 0 || !additive;
+                    if (moveCosts != costly) continue;
+
+                    if (tile >= 0) cells[tile] = static_cast<uint8_t>(blank);
+                    cells[k] = static_cast<uint8_t>(next);
+                    uint64_t rank = rankCells(cells, k + 1);
+                    uint8_t unseen = UNSEEN;
+                    if (distance[rank].compare_exchange_strong(unseen, static_cast<uint8_t>(depth), std::memory_order_relaxed)) {
+                        found[t].push_back(rank);
+                    }
+                    if (tile >= 0) cells[tile] = static_cast<uint8_t>(next);
+                    cells[k] = static_cast<uint8_t>(blank);
+                }
+            }
+        });
+        std::vector<uint64_t> result;
+        for (auto &part : found) {
+            result.insert(result.end(), part.begin(), part.end());
+        }
+        return result;
+    }
+};
+
+// A puzzle position, with the cell of every tile kept alongside the board
+struct Puzzle {
+    std::array<uint8_t, CELLS> board; // Tile in each cell
+    std::array<uint8_t, CELLS> cellOf; // Cell of each tile (index 0 is the blank)
+
+    static Puzzle goal() {
+        Puzzle puzzle;
+        for (int cell = 0; cell < CELLS; cell++) {
+            puzzle.board[cell] = static_cast<uint8_t>(cell);
+            puzzle.cellOf[cell] = static_cast<uint8_t>(cell);
+        }
+        return puzzle;
+    }
+
+    // Slide the tile in `cell` into the blank
+    void move(int cell) {
+        int blank = cellOf[0];
+        int tile = board[cell];
+        board[blank] = static_cast<uint8_t>(tile);
+        board[cell] = 0;
+        cellOf[tile] = static_cast<uint8_t>(blank);
+        cellOf[0] = static_cast<uint8_t>(cell);
+    }
+};
+
+typedef std::function<int(const Puzzle &)> Heuristic;
+
+int manhattan(const Puzzle &puzzle) {
+    int total = 0;
+    for (int tile = 1; tile < CELLS; tile++) {
+        int cell = puzzle.cellOf[tile];
+        total += std::abs(cell / SIDE - tile / SIDE) + std::abs(cell % SIDE - tile % SIDE);
+    }
+    return total;
+}
+
+// Maximum over groups of the sum of each group's (disjoint, additive) databases
+Heuristic patternHeuristic(const std::vector<std::vector<const PatternDatabase*>> &groups) {
+    return [groups](const Puzzle &puzzle) {
+        int best = 0;
+        for (const auto &group : groups) {
+            int sum = 0;
+            for (const PatternDatabase *database : group) {
+                sum += database->lookup(puzzle.cellOf.data());
+            }
+            best = std::max(best, sum);
+        }
+        return best;
+    };
+}
+
+// Iterative-deepening A* (IDA*); returns the solution length, counting expanded nodes
+class IdaStar {
+public:
+    unsigned long long expanded = 0;
+
+    explicit IdaStar(const Heuristic &heuristic) : heuristic(heuristic) {}
+
+    int solve(Puzzle puzzle) {
+        expanded = 0;
+        int bound = heuristic(puzzle);
+        while (true) {
+            int next = search(puzzle, 0, bound, -1);
+            if (next == FOUND) return bound;
+            bound = next;
+        }
+    }
+
+private:
+    static const int FOUND = -1;
+    Heuristic heuristic;
+
+    // FOUND, or the smallest f-cost above the bound
+    int search(Puzzle &puzzle, int g, int bound, int previousBlank) {
+        int f = g + heuristic(puzzle);
+        if (f > bound) return f;
+        if (f == g) return FOUND; // Heuristic zero: the goal
+        expanded++;
+        int blank = puzzle.cellOf[0];
+        int minimum = std::numeric_limits<int>::max();
+        for (int cell : NEIGHBOURS[blank]) {
+            if (cell == previousBlank) continue; // Do not undo the last move
+            puzzle.move(cell);
+            int result = search(puzzle, g + 1, bound, blank);
+            puzzle.move(blank);
+            if (result == FOUND) return FOUND;
+            minimum = std::min(minimum, result);
+        }
+        return minimum;
+    }
+};
+
+// Load a database from disk, or build and save it on first use
+void loadOrBuild(PatternDatabase &database, int numThreads) {
+    std::string path = database.additive ? "pdb_additive" : "pdb";
+    for (int tile : database.tiles) path += "_" + std::to_string(tile);
+    path += ".bin";
+    if (database.load(path)) {
+        std::cout << "Loaded " << path << " (" << database.sizeBytes() << " bytes, memory-mapped)\n";
+        return;
+    }
+    auto start = std::chrono::steady_clock::now();
+    database.build(numThreads);
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "Built " << path << " in " << seconds << " s (" << database.sizeBytes() << " bytes)\n";
+    if (database.save(path)) {
+        database.load(path);
+    }
+}
+
+int main() {
+    int numThreads = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+
+    // Two 5-5-5 partitions of the tiles: the sum over each partition, then the larger of the two
+    std::vector<std::vector<int>> rows = {{1, 2, 3, 4, 5}, {6, 7, 8, 9, 10}, {11, 12, 13, 14, 15}};
+    std::vector<std::vector<int>> columns = {{1, 5, 9, 13, 4}, {2, 6, 10, 14, 8}, {3, 7, 11, 15, 12}};
+    std::vector<std::unique_ptr<PatternDatabase>> databases;
+    std::vector<std::vector<const PatternDatabase*>> groups(2);
+    for (int g = 0; g < 2; g++) {
+        for (const auto &pattern : g == 0 ? rows : columns) {
+            databases.emplace_back(new PatternDatabase(pattern, true));
+            loadOrBuild(*databases.back(), numThreads);
+            groups[g].push_back(databases.back().get());
+        }
+    }
+
+    // Instances: random walks from the goal
+    std::mt19937 rng(7);
+    for (int instance = 0; instance < 5; instance++) {
+        Puzzle puzzle = Puzzle::goal();
+        int previous = -1;
+        for (int step = 0; step < 80; step++) {
+            const auto &options = NEIGHBOURS[puzzle.cellOf[0]];
+            int cell = options[rng() % options.size()];
+            if (cell == previous) continue;
+            previous = puzzle.cellOf[0];
+            puzzle.move(cell);
+        }
+
+        std::cout << "Instance " << instance << ":";
+        for (Heuristic heuristic : {Heuristic(manhattan), patternHeuristic(groups)}) {
+            IdaStar search(heuristic);
+            auto start = std::chrono::steady_clock::now();
+            int length = search.solve(puzzle);
+            double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            std::cout << "  " << length << " moves, " << search.expanded << " expanded in " << seconds << " s";
+        }
+        std::cout << "  (Manhattan vs pattern databases)" << std::endl;
+    }
+
+    return 0;
+}
@@ -0,0 +1,174 @@
+#ifndef QUERY_CACHE_H
+#define QUERY_CACHE_H
+
+#include <atomic>
+#include <mutex>
+#include <list>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <functional>
+#include <algorithm>
+#include <cstdint>
+#include <cstddef>
+
+// Answer to a path query: the path found and its cost, or found == false
+struct PathResult {
+    bool found = false;
+    long long cost = 0;
+    std::vector<std::string> path;
+};
+
+// Hit/miss counts summed over all shards
+struct QueryCacheStats {
+    uint64_t hits = 0;
+    uint64_t misses = 0;        // Includes stale entries
+    uint64_t stale = 0;         // Entries found but computed on an older graph version
+    uint64_t evictions = 0;
+    size_t entries = 0;
+
+    double hitRate() const {
+        return hits + misses ? static_cast<double>(hits) / (hits + misses) : 0.0;
+    }
+};
+
+// Bounded, thread-safe LRU cache of path query results.
+//
+// Keys are (algorithm, parameters, source, destination). Every entry records the version of the
+// graph it was computed on; a lookup with a newer version treats it as a miss and drops it, so
+// bumping the graph version invalidates the whole cache without touching it. The cache is split
+// into shards by key hash, each an LRU list plus a hash map under its own mutex, so threads asking
+// different queries rarely contend. Results are shared, immutable objects: a hit copies a pointer
+// under the lock, not the path.
+class QueryCache {
+public:
+    // At most `capacity` entries (spread evenly over the shards)
+    explicit QueryCache(size_t capacity = 4096, size_t shardCount = 16)
+        : shards(std::max<size_t>(shardCount, 1)) {
+        shardCapacity = std::max<size_t>(1, (capacity + shards.size() - 1) / shards.size());
+    }
+
+    QueryCache(const QueryCache &) = delete;
+    QueryCache &operator=(const QueryCache &) = delete;
+
+    static std::string key(const std::string &algorithm, const std::string &parameters,
+                           const std::string &source, const std::string &destination) {
+        // '\0' cannot appear in node names read from the terminal, so the parts cannot run together
+        std::string result;
+        result.reserve(algorithm.size() + parameters.size() + source.size() + destination.size() + 3);
+        result.append(algorithm).push_back('\0');
+        result.append(parameters).push_back('\0');
+        result.append(source).push_back('\0');
+        result.append(destination);
+        return result;
+    }
+
+    // Cached result for `key` computed on graph `version`, or nullptr
+    std::shared_ptr<const PathResult> lookup(const std::string &key, uint64_t version) {
+        Shard &shard = shardFor(key);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        auto it = shard.index.find(key);
+        if (it == shard.index.end()) {
+            shard.misses.fetch_add(1, std::memory_order_relaxed);
+            return nullptr;
+        }
+        if (it->second->version != version) {
+            // Drop results for an older graph; keep them if the caller is the one behind
+            if (it->second->version < version) {
+                shard.order.erase(it->second);
+                shard.index.erase(it);
+                shard.stale.fetch_add(1, std::memory_order_relaxed);
+            }
+            shard.misses.fetch_add(1, std::memory_order_relaxed);
+            return nullptr;
+        }
+        shard.order.splice(shard.order.begin(), shard.order, it->second); // Most recently used first
+        shard.hits.fetch_add(1, std::memory_order_relaxed);
+        return it->second->result;
+    }
+
+    // Store a result computed on graph `version`, evicting the least recently used entry if full.
+    // Returns the stored result.
+    std::shared_ptr<const PathResult> insert(const std::string &key, uint64_t version, PathResult result) {
+        auto shared = std::make_shared<const PathResult>(std::move(result));
+        Shard &shard = shardFor(key);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        auto it = shard.index.find(key);
+        if (it != shard.index.end()) {
+            // Another thread answered the same query; keep whichever is for the newer graph
+            if (it->second->version <= version) {
+                it->second->version = version;
+                it->second->result = shared;
+            }
+            shard.order.splice(shard.order.begin(), shard.order, it->second);
+            return shared;
+        }
+        if (shard.order.size() >= shardCapacity) {
+            shard.index.erase(shard.order.back().key);
+            shard.order.pop_back();
+            shard.evictions.fetch_add(1, std::memory_order_relaxed);
+        }
+        shard.order.push_front({key, version, shared});
+        shard.index.emplace(key, shard.order.begin());
+        return shared;
+    }
+
+    // Return the cached result, or compute it with fn() and cache it
+    template <typename Compute>
+    std::shared_ptr<const PathResult> getOrCompute(const std::string &key, uint64_t version, Compute fn) {
+        auto cached = lookup(key, version);
+        if (cached) return cached;
+        return insert(key, version, fn());
+    }
+
+    void clear() {
+        for (auto &shard : shards) {
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            shard.order.clear();
+            shard.index.clear();
+        }
+    }
+
+    QueryCacheStats stats() {
+        QueryCacheStats total;
+        for (auto &shard : shards) {
+            total.hits += shard.hits.load(std::memory_order_relaxed);
+            total.misses += shard.misses.load(std::memory_order_relaxed);
+            total.stale += shard.stale.load(std::memory_order_relaxed);
+            total.evictions += shard.evictions.load(std::memory_order_relaxed);
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            total.entries += shard.order.size();
+        }
+        return total;
+    }
+
+private:
+    struct Entry {
+        std::string key;
+        uint64_t version;
+        std::shared_ptr<const PathResult> result;
+    };
+
+    // Shards sit on separate cache lines so that their locks and counters do not false-share
+    struct alignas(64) Shard {
+        std::mutex mutex;
+        std::list<Entry> order; // Most recently used first
+        std::unordered_map<std::string, std::list<Entry>::iterator> index;
+        std::atomic<uint64_t> hits{0};
+        std::atomic<uint64_t> misses{0};
+        std::atomic<uint64_t> stale{0};
+        std::atomic<uint64_t> evictions{0};
+    };
+
+    std::vector<Shard> shards;
+    size_t shardCapacity = 1;
+
+    Shard &shardFor(const std::string &key) {
+        // Mix, then take high bits: std::hash may be weak in its low bits
+        uint64_t hash = std::hash<std::string>()(key) * 0x9e3779b97f4a7c15ULL;
+        return shards[(hash >> 32) % shards.size()];
+    }
+};
+
+#endif
@@ -0,0 +1,753 @@
+#include <iostream>
+#include <vector>
+#include <string>
+#include <queue>
+#include <deque>
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <memory>
+#include <chrono>
+#include <algorithm>
+#include <functional>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cctype>
+#include <cmath>
+#include <limits>
+#include "../snapshot_graph/snapshot_graph.h"
+#include "../query_cache/query_cache.h"
+#include "../dot_io/dot_io.h"
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include <signal.h>
+#define QUERY_SERVER_SOCKETS 1
+#endif
+
+// Long-running query server: loads one graph, then answers newline-delimited JSON requests on
+// stdin or a Unix domain socket, one JSON response line per request.
+//
+//   {"id": 1, "algorithm": "astar", "source": "A", "destination": "F", "options": {"cache": false}}
+//   {"id": 2, "op": "update", "insert": [["A", "G", 3]], "remove": [["C", "E"]], "setWeight": [["A", "B", 1]]}
+//   {"id": 3, "op": "stats"}
+//
+// Algorithms: "bfs" (fewest edges), "bnb" or "dijkstra" (cheapest path), "astar" (the heuristic
+// of a*/A_star.cpp). Requests are parsed and answered by a pool of worker threads, so responses
+// come back in completion order; "id" is echoed to match them up. Queries search a pinned
+// snapshot of the graph, so updates never block them, and answers are cached per graph version.
+
+// JSON
+
+struct JsonValue {
+    enum Type { NUL, BOOLEAN, NUMBER, STRING, ARRAY, OBJECT };
+    Type type = NUL;
+    bool boolean = false;
+    double number = 0;
+    std::string text;                                    // STRING, and the raw text of a NUMBER
+    std::vector<JsonValue> items;                        // ARRAY
+    std::vector<std::pair<std::string, JsonValue>> fields; // OBJECT
+
+    const JsonValue *get(const std::string &key) const {
+        for (const auto &field : fields) {
+            if (field.first == key) return &field.second;
+        }
+        return nullptr;
+    }
+};
+
+// Recursive-descent parser for one JSON document
+class JsonParser {
+public:
+    explicit JsonParser(const std::string &text) : text(text) {}
+
+    bool parse(JsonValue &value, std::string &error) {
+        if (!parseValue(value, 0)) {
+            error = message + " at offset " + std::to_string(position);
+            return false;
+        }
+        skipSpace();
+        if (position != text.size()) {
+            error = "unexpected text after the JSON value at offset " + std::to_string(position);
+            return false;
+        }
+        return true;
+    }
+
+private:
+    static const int MAX_DEPTH = 64;
+
+    const std::string &text;
+    size_t position = 0;
+    std::string message;
+
+    bool fail(const char *why) {
+        message = why;
+        return false;
+    }
+
+    void skipSpace() {
+        while (position < text.size() && (text[position] == ' ' || text[position] == '\t' ||
+                                          text[position] == '\r' || text[position] == '\n')) {
+            position++;
+        }
+    }
+
+    bool literal(const char *word) {
+        size_t length = std::strlen(word);
+        if (text.compare(position, length, word) != 0) return fail("invalid literal");
+        position += length;
+        return true;
+    }
+
+    static void appendUtf8(std::string &out, uint32_t code) {
+        if (code < 0x80) {
+            out.push_back(static_cast<char>(code));
+        } else if (code < 0x800) {
+            out.push_back(static_cast<char>(0xC0 | (code >> 6)));
+            out.push_back(static_cast<char>(0x80 | (code & 0x3F)));
+        } else if (code < 0x10000) {
+            out.push_back(static_cast<char>(0xE0 | (code >> 12)));
+            out.push_back(static_cast<char>(0x80 | ((code >> 6) & 0x3F)));
+            out.push_back(static_cast<char>(0x80 | (code & 0x3F)));
+        } else {
+            out.push_back(static_cast<char>(0xF0 | (code >> 18)));
+            out.push_back(static_cast<char>(0x80 | ((code >> 12) & 0x3F)));
+            out.push_back(static_cast<char>(0x80 | ((code >> 6) & 0x3F)));
+            out.push_back(static_cast<char>(0x80 | (code & 0x3F)));
+        }
+    }
+
+    bool hex4(uint32_t &code) {
+        if (position + 4 > text.size()) return fail("truncated \\u escape");
+        code = 0;
+        for (int i = 0; i < 4; i++) {
+            char c = text[position++];
+            code <<= 4;
+            if (c >= '0' && c <= '9') code |= c - '0';
+            else if (c >= 'a' && c <= 'f') code |= c - 'a' + 10;
+            else if (c >= 'A' && c <= 'F') code |= c - 'A' + 10;
+            else return fail("invalid \\u escape");
+        }
+        return true;
+    }
+
+    bool parseString(std::string &out) {
+        position++; // Opening quote
+        for (;;) {
+            if (position >= text.size()) return fail("unterminated string");
+            char c = text[position++];
+            if (c == '"') return true;
+            if (static_cast<unsigned char>(c) < 0x20) return fail("control character in string");
+            if (c != '\\') {
+                out.push_back(c);
+                continue;
+            }
+            if (position >= text.size()) return fail("unterminated string");
+            c = text[position++];
+            switch (c) {
+            case '"': out.push_back('"'); break;
+            case '\\': out.push_back('\\'); break;
+            case '/': out.push_back('/'); break;
+            case 'b': out.push_back('\b'); break;
+            case 'f': out.push_back('\f'); break;
+            case 'n': out.push_back('\n'); break;
+            case 'r': out.push_back('\r'); break;
+            case 't': out.push_back('\t'); break;
+            case 'u': {
+                uint32_t code;
+                if (!hex4(code)) return false;
+                if (code >= 0xD800 && code < 0xDC00) { // Surrogate pair
+                    uint32_t low;
+                    if (text.compare(position, 2, "\\u") != 0) return fail("unpaired surrogate");
+                    position += 2;
+                    if (!hex4(low) || low < 0xDC00 || low >= 0xE000) return fail("unpaired surrogate");
+                    code = 0x10000 + ((code - 0xD800) << 10) + (low - 0xDC00);
+                }
+                appendUtf8(out, code);
+                break;
+            }
+            default:
+                return fail("invalid escape");
+            }
+        }
+    }
+
+    bool parseNumber(JsonValue &value) {
+        size_t start = position;
+        if (text[position] == '-') position++;
+        while (position < text.size() && (std::isdigit(static_cast<unsigned char>(text[position])) ||
+                                          text[position] == '.' || text[position] == 'e' || text[position] == 'E' ||
+                                          text[position] == '+' || text[position] == '-')) {
+            position++;
+        }
+        value.type = JsonValue::NUMBER;
+        value.text = text.substr(start, position - start);
+        char *end = nullptr;
+        value.number = std::strtod(value.text.c_str(), &end);
+        if (value.text.empty() || *end != '\0') return fail("invalid number");
+        return true;
+    }
+
+    bool parseValue(JsonValue &value, int depth) {
+        if (depth > MAX_DEPTH) return fail("nested too deeply");
+        skipSpace();
+        if (position >= text.size()) return fail("unexpected end of input");
+        char c = text[position];
+        if (c == '{') {
+            value.type = JsonValue::OBJECT;
+            position++;
+            skipSpace();
+            if (position < text.size() && text[position] == '}') {
+                position++;
+                return true;
+            }
+            for (;;) {
+                skipSpace();
+                if (position >= text.size() || text[position] != '"') return fail("expected a key");
+                std::string key;
+                if (!parseString(key)) return false;
+                skipSpace();
+                if (position >= text.size() || text[position] != ':') return fail("expected ':'");
+                position++;
+                value.fields.push_back({std::move(key), JsonValue()});
+                if (!parseValue(value.fields.back().second, depth + 1)) return false;
+                skipSpace();
+                if (position < text.size() && text[position] == ',') {
+                    position++;
+                } else if (position < text.size() && text[position] == '}') {
+                    position++;
+                    return true;
+                } else {
+                    return fail("expected ',' or '}'");
+                }
+            }
+        }
+        if (c == '[') {
+            value.type = JsonValue::ARRAY;
+            position++;
+            skipSpace();
+            if (position < text.size() && text[position] == ']') {
+                position++;
+                return true;
+            }
+            for (;;) {
+                value.items.emplace_back();
+                if (!parseValue(value.items.back(), depth + 1)) return false;
+                skipSpace();
+                if (position < text.size() && text[position] == ',') {
+                    position++;
+                } else if (position < text.size() && text[position] == ']') {
+                    position++;
+                    return true;
+                } else {
+                    return fail("expected ',' or ']'");
+                }
+            }
+        }
+        if (c == '"') {
+            value.type = JsonValue::STRING;
+            return parseString(value.text);
+        }
+        if (c == 't') {
+            value.type = JsonValue::BOOLEAN;
+            value.boolean = true;
+            return literal("true");
+        }
+        if (c == 'f') {
+            value.type = JsonValue::BOOLEAN;
+            return literal("false");
+        }
+        if (c == 'n') return literal("null");
+        if (c == '-' || std::isdigit(static_cast<unsigned char>(c))) return parseNumber(value);
+        return fail("unexpected character");
+    }
+};
+
+void appendJsonString(std::string &out, const std::string &text) {
+    out.push_back('"');
+    for (unsigned char c : text) {
+        if (c == '"' || c == '\\') {
+            out.push_back('\\');
+            out.push_back(static_cast<char>(c));
+        } else if (c < 0x20) {
+            char escaped[8];
+            std::snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+            out += escaped;
+        } else {
+            out.push_back(static_cast<char>(c));
+        }
+    }
+    out.push_back('"');
+}
+
+// The request's "id" echoed back as JSON (strings quoted, numbers as written)
+std::string idJson(const JsonValue *id) {
+    if (!id) return "null";
+    std::string out;
+    if (id->type == JsonValue::STRING) appendJsonString(out, id->text);
+    else if (id->type == JsonValue::NUMBER) out = id->text;
+    else out = "null";
+    return out;
+}
+
+// Searches on one pinned snapshot
+
+// Parent pointers are set when a node is expanded, from the open-list entry that reached it
+PathResult buildPath(const GraphSnapshot &graph, const std::vector<int> &parent, int destination, long long cost) {
+    PathResult result;
+    result.found = true;
+    result.cost = cost;
+    for (int node = destination; node != -1; node = parent[node]) {
+        result.path.push_back(graph.name(node));
+    }
+    std::reverse(result.path.begin(), result.path.end());
+    return result;
+}
+
+// Fewest edges
+PathResult breadthFirst(const GraphSnapshot &graph, int source, int destination, size_t &expanded) {
+    std::vector<int> parent(graph.nodeCount(), -2);
+    std::vector<long long> cost(graph.nodeCount(), 0);
+    std::deque<int> frontier = {source};
+    parent[source] = -1;
+    while (!frontier.empty()) {
+        int node = frontier.front();
+        frontier.pop_front();
+        expanded++;
+        if (node == destination) return buildPath(graph, parent, destination, cost[node]);
+        for (const auto &edge : graph.edges(node)) {
+            if (parent[edge.target] == -2) {
+                parent[edge.target] = node;
+                cost[edge.target] = cost[node] + edge.weight;
+                frontier.push_back(edge.target);
+            }
+        }
+    }
+    return PathResult();
+}
+
+// Best-first search with an extended list: Dijkstra (branch and bound) when useHeuristic is false,
+// A* with the heuristic of a*/A_star.cpp (distance between first letters) when it is true
+PathResult bestFirst(const GraphSnapshot &graph, int source, int destination, bool useHeuristic, size_t &expanded) {
+    struct Entry {
+        double f;
+        long long g;
+        int node;
+        int parent;
+        bool operator>(const Entry &other) const {
+            return f > other.f;
+        }
+    };
+    const std::string &goal = graph.name(destination);
+    auto heuristic = [&](int node) -> double {
+        if (!useHeuristic) return 0;
+        const std::string &name = graph.name(node);
+        return name.empty() || goal.empty() ? 0 : std::abs(static_cast<int>(name[0]) - static_cast<int>(goal[0]));
+    };
+
+    std::vector<int> parent(graph.nodeCount(), -1);
+    std::vector<char> extended(graph.nodeCount(), 0);
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> open;
+    open.push({heuristic(source), 0, source, -1});
+    while (!open.empty()) {
+        Entry current = open.top();
+        open.pop();
+        if (extended[current.node]) continue;
+        extended[current.node] = 1;
+        parent[current.node] = current.parent;
+        expanded++;
+        if (current.node == destination) return buildPath(graph, parent, destination, current.g);
+        for (const auto &edge : graph.edges(current.node)) {
+            if (!extended[edge.target]) {
+                long long g = current.g + edge.weight;
+                open.push({g + heuristic(edge.target), g, edge.target, current.node});
+            }
+        }
+    }
+    return PathResult();
+}
+
+// Connections: where responses go
+
+class Connection {
+public:
+    virtual ~Connection() {}
+    virtual void send(const std::string &line) = 0;
+};
+
+class StdoutConnection : public Connection {
+public:
+    void send(const std::string &line) override {
+        std::lock_guard<std::mutex> lock(mutex);
+        std::fwrite(line.data(), 1, line.size(), stdout);
+        std::fflush(stdout);
+    }
+
+private:
+    std::mutex mutex;
+};
+
+#ifdef QUERY_SERVER_SOCKETS
+class SocketConnection : public Connection {
+public:
+    explicit SocketConnection(int fd) : fd(fd) {}
+
+    ~SocketConnection() override {
+        ::close(fd);
+    }
+
+    void send(const std::string &line) override {
+        std::lock_guard<std::mutex> lock(mutex);
+        size_t sent = 0;
+        while (sent < line.size()) {
+            ssize_t n = ::send(fd, line.data() + sent, line.size() - sent, MSG_NOSIGNAL);
+            if (n <= 0) return; // Client went away; drop the response
+            sent += static_cast<size_t>(n);
+        }
+    }
+
+    int fd;
+
+private:
+    std::mutex mutex;
+};
+#endif
+
+// Server
+
+class QueryServer {
+public:
+    QueryServer(int numThreads, size_t cacheEntries) : cache(cacheEntries) {
+        for (int t = 0; t < std::max(1, numThreads); t++) {
+            workers.emplace_back([this] { workLoop(); });
+        }
+    }
+
+    ~QueryServer() {
+        {
+            std::lock_guard<std::mutex> lock(queueMutex);
+            stopping = true;
+        }
+        queueReady.notify_all();
+        for (auto &worker : workers) {
+            worker.join();
+        }
+    }
+
+    SnapshotGraph graph;
+
+    // Queue one request line; blocks while too many requests are waiting
+    void submit(std::shared_ptr<Connection> connection, std::string line) {
+        std::unique_lock<std::mutex> lock(queueMutex);
+        queueSpace.wait(lock, [this] { return jobs.size() < MAX_QUEUED; });
+        jobs.push_back({std::move(connection), std::move(line)});
+        queueReady.notify_one();
+    }
+
+    // Wait until every submitted request has been answered
+    void drain() {
+        std::unique_lock<std::mutex> lock(queueMutex);
+        idle.wait(lock, [this] { return jobs.empty() && busy == 0; });
+    }
+
+    // Read request lines from `input` until end of input, answering on `connection`
+    void serveStream(FILE *input, std::shared_ptr<Connection> connection) {
+        std::string line;
+        char chunk[65536];
+        while (std::fgets(chunk, sizeof(chunk), input)) {
+            line += chunk;
+            if (line.back() != '\n' && !std::feof(input)) continue; // Longer than one chunk
+            while (!line.empty() && (line.back() == '\n' || line.back() == '\r')) line.pop_back();
+            if (!line.empty()) submit(connection, std::move(line));
+            line.clear();
+        }
+        if (!line.empty()) submit(connection, std::move(line));
+    }
+
+private:
+    static const size_t MAX_QUEUED = 4096;
+
+    struct Job {
+        std::shared_ptr<Connection> connection;
+        std::string line;
+    };
+
+    QueryCache cache;
+    std::vector<std::thread> workers;
+    std::mutex queueMutex;
+    std::condition_variable queueReady, queueSpace, idle;
+    std::deque<Job> jobs;
+    int busy = 0;
+    bool stopping = false;
+
+    void workLoop() {
+        for (;;) {
+            Job job;
+            {
+                std::unique_lock<std::mutex> lock(queueMutex);
+                queueReady.wait(lock, [this] { return stopping || !jobs.empty(); });
+                if (jobs.empty()) return;
+                job = std::move(jobs.front());
+                jobs.pop_front();
+                busy++;
+            }
+            queueSpace.notify_one();
+            std::string response = handle(job.line);
+            response.push_back('\n');
+            job.connection->send(response);
+            job.connection.reset(); // A socket closes once its last response is sent
+            {
+                std::lock_guard<std::mutex> lock(queueMutex);
+                busy--;
+                if (jobs.empty() && busy == 0) idle.notify_all();
+            }
+        }
+    }
+
+    static std::string errorResponse(const std::string &id, const std::string &message) {
+        std::string out = "{\"id\":" + id + ",\"ok\":false,\"error\":";
+        appendJsonString(out, message);
+        out += "}";
+        return out;
+    }
+
+    std::string handle(const std::string &line) {
+        JsonValue request;
+        std::string error;
+        if (!JsonParser(line).parse(request, error)) return errorResponse("null", "invalid JSON: " + error);
+        if (request.type != JsonValue::OBJECT) return errorResponse("null", "request must be a JSON object");
+        std::string id = idJson(request.get("id"));
+
+        const JsonValue *op = request.get("op");
+        std::string operation = op && op->type == JsonValue::STRING ? op->text : "query";
+        if (operation == "query") return query(request, id);
+        if (operation == "update") return update(request, id);
+        if (operation == "stats") return stats(id);
+        return errorResponse(id, "unknown op \"" + operation + "\"");
+    }
+
+    std::string query(const JsonValue &request, const std::string &id) {
+        auto stringField = [&](const char *key) -> const std::string * {
+            const JsonValue *value = request.get(key);
+            return value && value->type == JsonValue::STRING ? &value->text : nullptr;
+        };
+        const std::string *algorithmName = stringField("algorithm");
+        const std::string *source = stringField("source");
+        const std::string *destination = stringField("destination");
+        if (!algorithmName || !source || !destination) {
+            return errorResponse(id, "a query needs string fields algorithm, source and destination");
+        }
+        std::string algorithm = *algorithmName == "dijkstra" ? "bnb" : *algorithmName;
+        if (algorithm != "bfs" && algorithm != "bnb" && algorithm != "astar") {
+            return errorResponse(id, "unknown algorithm \"" + *algorithmName + "\" (bfs, bnb, dijkstra, astar)");
+        }
+        bool useCache = true;
+        if (const JsonValue *options = request.get("options")) {
+            const JsonValue *cacheOption = options->get("cache");
+            if (cacheOption && cacheOption->type == JsonValue::BOOLEAN) useCache = cacheOption->boolean;
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        auto snapshot = graph.pin();
+        int from = snapshot->id(*source), to = snapshot->id(*destination);
+        if (from < 0 || to < 0) return errorResponse(id, "unknown node \"" + (from < 0 ? *source : *destination) + "\"");
+
+        size_t expanded = 0;
+        bool computed = false;
+        auto compute = [&] {
+            computed = true;
+            if (algorithm == "bfs") return breadthFirst(*snapshot, from, to, expanded);
+            return bestFirst(*snapshot, from, to, algorithm == "astar", expanded);
+        };
+        std::shared_ptr<const PathResult> result;
+        if (useCache) {
+            result = cache.getOrCompute(QueryCache::key(algorithm, "", *source, *destination), snapshot->version(), compute);
+        } else {
+            result = std::make_shared<const PathResult>(compute());
+        }
+        double micros = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+
+        std::string out = "{\"id\":" + id + ",\"ok\":true,\"algorithm\":";
+        appendJsonString(out, algorithm);
+        out += ",\"version\":" + std::to_string(snapshot->version()) + ",\"found\":" + (result->found ? "true" : "false");
+        if (result->found) {
+            out += ",\"cost\":" + std::to_string(result->cost) + ",\"path\":[";
+            for (size_t i = 0; i < result->path.size(); i++) {
+                if (i) out.push_back(',');
+                appendJsonString(out, result->path[i]);
+            }
+            out += "]";
+        }
+        char timing[64];
+        std::snprintf(timing, sizeof(timing), "%.1f", micros);
+        out += std::string(",\"cached\":") + (computed ? "false" : "true") + ",\"expanded\":" + std::to_string(expanded) +
+               ",\"micros\":" + timing + "}";
+        return out;
+    }
+
+    // Apply "insert", "remove" and "setWeight" lists as one batch (one new graph version)
+    std::string update(const JsonValue &request, const std::string &id) {
+        GraphBatch batch;
+        const char *lists[] = {"insert", "remove", "setWeight"};
+        for (int kind = 0; kind < 3; kind++) {
+            const JsonValue *list = request.get(lists[kind]);
+            if (!list) continue;
+            if (list->type != JsonValue::ARRAY) return errorResponse(id, std::string(lists[kind]) + " must be an array");
+            for (const auto &edge : list->items) {
+                size_t fields = kind == 1 ? 2 : 3;
+                if (edge.type != JsonValue::ARRAY || edge.items.size() != fields ||
+                    edge.items[0].type != JsonValue::STRING || edge.items[1].type != JsonValue::STRING ||
+                    (fields == 3 && edge.items[2].type != JsonValue::NUMBER)) {
+                    return errorResponse(id, std::string(lists[kind]) +
+                                                 (fields == 3 ? " entries are [from, to, weight]" : " entries are [from, to]"));
+                }
+                // Weights are stored as int and the searches assume they are non-negative
+                double weight = fields == 3 ? edge.items[2].number : 0;
+                if (!(weight >= 0 && weight <= std::numeric_limits<int>::max() && std::floor(weight) == weight)) {
+                    return errorResponse(id, std::string(lists[kind]) + " weight " + edge.items[2].text +
+                                                 " is not an integer from 0 to " + std::to_string(std::numeric_limits<int>::max()));
+                }
+                const std::string &from = edge.items[0].text, &to = edge.items[1].text;
+                if (kind == 0) batch.insertEdge(from, to, static_cast<int>(weight));
+                else if (kind == 1) batch.removeEdge(from, to);
+                else batch.setWeight(from, to, static_cast<int>(weight));
+            }
+        }
+        uint64_t version = graph.apply(batch);
+        return "{\"id\":" + id + ",\"ok\":true,\"version\":" + std::to_string(version) +
+               ",\"changes\":" + std::to_string(batch.size()) + "}";
+    }
+
+    std::string stats(const std::string &id) {
+        QueryCacheStats cacheStats = cache.stats();
+        auto snapshot = graph.pin();
+        char hitRate[32];
+        std::snprintf(hitRate, sizeof(hitRate), "%.3f", cacheStats.hitRate());
+        return "{\"id\":" + id + ",\"ok\":true,\"version\":" + std::to_string(snapshot->version()) +
+               ",\"nodes\":" + std::to_string(snapshot->nodeCount()) + ",\"workers\":" + std::to_string(workers.size()) +
+               ",\"cache\":{\"entries\":" + std::to_string(cacheStats.entries) + ",\"hits\":" + std::to_string(cacheStats.hits) +
+               ",\"misses\":" + std::to_string(cacheStats.misses) + ",\"stale\":" + std::to_string(cacheStats.stale) +
+               ",\"evictions\":" + std::to_string(cacheStats.evictions) + ",\"hitRate\":" + hitRate + "}}";
+    }
+};
+
+// Load the graph from a DOT file (edge weights from label/weight, 1 if absent), or the sample
+// graph of a*/A_star.cpp without one
+bool loadGraph(SnapshotGraph &graph, const std::string &filename) {
+    GraphBatch batch;
+    if (filename.empty()) {
+        batch.insertEdge("A", "B", 4);
+        batch.insertEdge("A", "C", 2);
+        batch.insertEdge("B", "D", 5);
+        batch.insertEdge("C", "D", 8);
+        batch.insertEdge("C", "E", 10);
+        batch.insertEdge("D", "E", 2);
+        batch.insertEdge("D", "F", 6);
+        batch.insertEdge("E", "F", 3);
+        graph.apply(batch);
+        return true;
+    }
+    // Publish in slices so that a huge file never holds all its edges twice
+    const size_t SLICE = 1 << 20;
+    DotReader reader;
+    std::string badWeight; // The first negative weight; the searches assume there are none
+    bool ok = reader.read(filename, [&](const std::string &from, const std::string &to, int weight, bool hasWeight) {
+        if (hasWeight && weight < 0) {
+            if (badWeight.empty()) {
+                badWeight = "line " + std::to_string(reader.lineNumber()) + ": weight " + std::to_string(weight) +
+                            " of " + from + " -- " + to + " is not an integer from 0 to " +
+                            std::to_string(std::numeric_limits<int>::max());
+            }
+            return;
+        }
+        batch.insertEdge(from, to, hasWeight ? weight : 1);
+        if (batch.size() == SLICE) {
+            graph.apply(batch);
+            batch.clear();
+        }
+    });
+    if (ok && !badWeight.empty()) {
+        reader.error = badWeight;
+        ok = false;
+    }
+    if (!ok) {
+        std::cerr << "Could not load " << filename << ": " << reader.error << std::endl;
+        return false;
+    }
+    graph.apply(batch);
+    return true;
+}
+
+// Usage: query_server [--graph file.dot] [--socket path] [--threads n] [--cache entries]
+int main(int argc, char *argv[]) {
+    std::string graphFile, socketPath;
+    int numThreads = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+    size_t cacheEntries = 65536;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (i + 1 < argc && arg == "--graph") graphFile = argv[++i];
+        else if (i + 1 < argc && arg == "--socket") socketPath = argv[++i];
+        else if (i + 1 < argc && arg == "--threads") numThreads = std::max(1, std::atoi(argv[++i]));
+        else if (i + 1 < argc && arg == "--cache") cacheEntries = std::strtoull(argv[++i], nullptr, 10);
+        else {
+            std::cerr << "Usage: query_server [--graph file.dot] [--socket path] [--threads n] [--cache entries]\n";
+            return 1;
+        }
+    }
+
+    QueryServer server(numThreads, cacheEntries);
+    if (!loadGraph(server.graph, graphFile)) return 1;
+    {
+        auto snapshot = server.graph.pin();
+        std::cerr << "Graph loaded: " << snapshot->nodeCount() << " nodes, " << numThreads << " worker threads" << std::endl;
+    }
+
+    if (socketPath.empty()) {
+        server.serveStream(stdin, std::make_shared<StdoutConnection>());
+        server.drain();
+        return 0;
+    }
+
+#ifdef QUERY_SERVER_SOCKETS
+    signal(SIGPIPE, SIG_IGN);
+    int listener = socket(AF_UNIX, SOCK_STREAM, 0);
+    sockaddr_un address = {};
+    address.sun_family = AF_UNIX;
+    if (listener < 0 || socketPath.size() >= sizeof(address.sun_path)) {
+        std::cerr << "Cannot create socket " << socketPath << std::endl;
+        return 1;
+    }
+    std::strcpy(address.sun_path, socketPath.c_str());
+    unlink(socketPath.c_str());
+    if (bind(listener, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 || listen(listener, 64) != 0) {
+        std::cerr << "Cannot listen on " << socketPath << ": " << std::strerror(errno) << std::endl;
+        return 1;
+    }
+    std::cerr << "Listening on " << socketPath << std::endl;
+    for (;;) {
+        int fd = accept(listener, nullptr, nullptr);
+        if (fd < 0) {
+            if (errno == EINTR) continue;
+            break;
+        }
+        // One reader thread per client; requests from all clients share the worker pool
+        std::thread([&server, fd] {
+            auto connection = std::make_shared<SocketConnection>(fd);
+            FILE *input = fdopen(dup(fd), "r");
+            if (!input) return;
+            server.serveStream(input, connection);
+            std::fclose(input);
+        }).detach();
+    }
+    close(listener);
+    return 1;
+#else
+    std::cerr << "Unix domain sockets are not available on this platform; use stdin." << std::endl;
+    return 1;
+#endif
+}
@@ -0,0 +1,319 @@
+#ifndef SEARCH_TRACE_H
+#define SEARCH_TRACE_H
+
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <utility>
+#include <cstdio>
+#include <cstdint>
+#include <cstring>
+
+// Binary search traces: what a search expanded, pushed, pruned and reached, in order, for replay.
+//
+// File layout (little-endian):
+//   TraceFileHeader
+//   blocks: TraceBlockHeader followed by `count` TraceEvents, from any thread, in flush order
+//   name table: uint32 count, then per node (uint32 id, uint32 length, name bytes)
+//   TraceFileFooter (offset of the name table)
+// Event times are nanoseconds since the block's start, which is nanoseconds since the trace
+// started, so events of one thread are ordered and threads can be merged by time.
+
+enum TraceEventKind : uint32_t {
+    TRACE_EXPAND = 0, // Node taken from the open list and expanded
+    TRACE_PUSH = 1,   // Node added to the open list (parent = node it was reached from)
+    TRACE_PRUNE = 2,  // Node discarded (already expanded, or bounded out)
+    TRACE_GOAL = 3    // Destination reached (cost = path cost)
+};
+
+const uint32_t TRACE_NO_NODE = 0xFFFFFFFFu;
+
+struct TraceEvent {
+    uint32_t node;
+    uint32_t parent;         // TRACE_NO_NODE if none
+    int32_t cost;
+    uint32_t kindAndTime;    // Kind in the top 3 bits, nanoseconds since the block start below
+
+    static const int TIME_BITS = 29;
+    static const uint32_t TIME_MASK = (1u << TIME_BITS) - 1;
+
+    TraceEventKind kind() const {
+        return static_cast<TraceEventKind>(kindAndTime >> TIME_BITS);
+    }
+
+    uint32_t time() const {
+        return kindAndTime & TIME_MASK;
+    }
+};
+
+struct TraceFileHeader {
+    char magic[8];           // "STRACE1"
+    uint32_t eventSize;      // sizeof(TraceEvent)
+    uint32_t reserved;
+};
+
+struct TraceBlockHeader {
+    uint32_t magic;          // TRACE_BLOCK_MAGIC
+    uint32_t thread;         // Recording thread, numbered from 0 in order of first event
+    uint32_t count;          // Events in the block
+    uint32_t reserved;
+    uint64_t startNs;        // Block start, nanoseconds since the trace started
+};
+
+struct TraceFileFooter {
+    uint64_t namesOffset;    // File offset of the name table
+    char magic[8];           // "STRACEZ"
+};
+
+const uint32_t TRACE_BLOCK_MAGIC = 0x4B4C4254; // "TBLK"
+
+// Records trace events from any number of threads into a file.
+//
+// Each thread writes into its own ring of fixed-size blocks, with no locks or shared cache lines
+// on the recording path. A full block is handed to a background thread that writes it out; a
+// thread only waits if its whole ring is still unwritten. Searches hold a `TraceRecorder *`
+// that is null unless tracing was asked for, so disabled tracing costs one predictable branch
+// per event. Nodes are identified by number; intern() numbers string names.
+class TraceRecorder {
+public:
+    static const size_t BLOCK_EVENTS = 4096; // 64 KB blocks
+    static const size_t RING_BLOCKS = 8;
+
+    explicit TraceRecorder(const std::string &filename) : id(nextRecorderId()) {
+        file = std::fopen(filename.c_str(), "wb");
+        if (!file) return;
+        TraceFileHeader header = {};
+        std::memcpy(header.magic, "STRACE1", 8);
+        header.eventSize = sizeof(TraceEvent);
+        std::fwrite(&header, sizeof(header), 1, file);
+        start = std::chrono::steady_clock::now();
+        flusher = std::thread([this] { flushLoop(); });
+    }
+
+    ~TraceRecorder() {
+        close();
+    }
+
+    TraceRecorder(const TraceRecorder &) = delete;
+    TraceRecorder &operator=(const TraceRecorder &) = delete;
+
+    bool ok() const {
+        return file && !failed;
+    }
+
+    // Does nothing if the file could not be opened (no writer thread would ever drain the ring)
+    // or the recorder is closed
+    void record(TraceEventKind kind, uint32_t node, uint32_t parent, int32_t cost) {
+        if (!file) return;
+        ThreadBuffer &buffer = localBuffer();
+        uint64_t now = nowNs();
+        if (buffer.fill == BLOCK_EVENTS || now - buffer.blockStart > TraceEvent::TIME_MASK) {
+            if (buffer.fill) publish(buffer);
+            buffer.blockStart = now;
+        }
+        Block &block = buffer.blocks[buffer.written % RING_BLOCKS];
+        block.events[buffer.fill++] = {node, parent, cost,
+                                       static_cast<uint32_t>(kind) << TraceEvent::TIME_BITS |
+                                           static_cast<uint32_t>(now - buffer.blockStart)};
+    }
+
+    void expand(uint32_t node, uint32_t parent, int32_t cost) {
+        record(TRACE_EXPAND, node, parent, cost);
+    }
+
+    void push(uint32_t node, uint32_t parent, int32_t cost) {
+        record(TRACE_PUSH, node, parent, cost);
+    }
+
+    void prune(uint32_t node, uint32_t parent, int32_t cost) {
+        record(TRACE_PRUNE, node, parent, cost);
+    }
+
+    void goal(uint32_t node, uint32_t parent, int32_t cost) {
+        record(TRACE_GOAL, node, parent, cost);
+    }
+
+    // Number for a node name, the same every time the name is seen
+    uint32_t intern(const std::string &name) {
+        std::lock_guard<std::mutex> lock(namesMutex);
+        auto it = nameIds.find(name);
+        if (it != nameIds.end()) return it->second;
+        uint32_t node = static_cast<uint32_t>(names.size());
+        names.push_back(name);
+        nameIds.emplace(name, node);
+        return node;
+    }
+
+    // Write everything recorded and close the file. Recording threads must have stopped.
+    // Returns false if anything failed to write.
+    bool close() {
+        if (!file) return false;
+        {
+            std::lock_guard<std::mutex> lock(flushMutex);
+            for (auto &buffer : buffers) {
+                if (buffer->fill) publish(*buffer, false);
+            }
+            stopping = true;
+        }
+        flushSignal.notify_one();
+        flusher.join();
+
+        TraceFileFooter footer = {};
+        footer.namesOffset = static_cast<uint64_t>(std::ftell(file));
+        uint32_t count = static_cast<uint32_t>(names.size());
+        std::fwrite(&count, sizeof(count), 1, file);
+        for (uint32_t node = 0; node < count; node++) {
+            uint32_t length = static_cast<uint32_t>(names[node].size());
+            std::fwrite(&node, sizeof(node), 1, file);
+            std::fwrite(&length, sizeof(length), 1, file);
+            std::fwrite(names[node].data(), 1, length, file);
+        }
+        std::memcpy(footer.magic, "STRACEZ", 8);
+        if (std::fwrite(&footer, sizeof(footer), 1, file) != 1) failed = true;
+        if (std::fclose(file) != 0) failed = true;
+        file = nullptr;
+        return !failed;
+    }
+
+    uint64_t eventCount() const {
+        return events.load(std::memory_order_relaxed);
+    }
+
+    // Times a recording thread found its ring full and had to wait for the writer
+    uint64_t stallCount() const {
+        return stalls.load(std::memory_order_relaxed);
+    }
+
+private:
+    struct Block {
+        TraceEvent events[BLOCK_EVENTS];
+    };
+
+    struct BlockInfo {
+        uint64_t startNs;
+        uint32_t count;
+    };
+
+    // One per recording thread. The owner writes `fill` and the current block; the writer thread
+    // reads published blocks. `written` and `flushed` count blocks and sit on separate lines.
+    struct ThreadBuffer {
+        uint32_t thread;
+        size_t fill = 0;
+        uint64_t blockStart = 0;
+        Block blocks[RING_BLOCKS];
+        BlockInfo info[RING_BLOCKS];
+        size_t written = 0; // Owner's copy of `published`
+        alignas(64) std::atomic<size_t> published{0};
+        alignas(64) std::atomic<size_t> flushed{0};
+    };
+
+    const uint64_t id;
+    FILE *file = nullptr;
+    bool failed = false;
+    std::chrono::steady_clock::time_point start;
+
+    std::mutex flushMutex;                 // Guards `buffers` and `stopping`
+    std::condition_variable flushSignal;
+    bool stopping = false;
+    std::vector<std::unique_ptr<ThreadBuffer>> buffers;
+    std::thread flusher;
+    std::atomic<uint64_t> events{0};
+    std::atomic<uint64_t> stalls{0};
+
+    std::mutex namesMutex;
+    std::vector<std::string> names;
+    std::unordered_map<std::string, uint32_t> nameIds;
+
+    static uint64_t nextRecorderId() {
+        static std::atomic<uint64_t> counter{0};
+        return ++counter;
+    }
+
+    uint64_t nowNs() const {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    // This thread's buffer, registered on its first event for this recorder. Each thread keeps a
+    // small list of (recorder id, buffer), shared by all recorders, with the last one used cached
+    // in front of it, so switching between recorders never registers a second buffer. Recorders
+    // are told apart by id rather than address, so a new recorder at a freed one's address is not
+    // mistaken for it.
+    ThreadBuffer &localBuffer() {
+        thread_local uint64_t owner = 0;
+        thread_local ThreadBuffer *buffer = nullptr;
+        thread_local std::vector<std::pair<uint64_t, ThreadBuffer*>> known;
+        if (owner == id) return *buffer;
+        for (const auto &entry : known) {
+            if (entry.first == id) {
+                owner = id;
+                buffer = entry.second;
+                return *buffer;
+            }
+        }
+        {
+            std::lock_guard<std::mutex> lock(flushMutex);
+            buffers.push_back(std::unique_ptr<ThreadBuffer>(new ThreadBuffer()));
+            buffer = buffers.back().get();
+            buffer->thread = static_cast<uint32_t>(buffers.size() - 1);
+        }
+        known.push_back({id, buffer});
+        owner = id;
+        return *buffer;
+    }
+
+    // Hand the current block to the writer thread, waiting first if the ring is full
+    void publish(ThreadBuffer &buffer, bool wait = true) {
+        buffer.info[buffer.written % RING_BLOCKS] = {buffer.blockStart, static_cast<uint32_t>(buffer.fill)};
+        events.fetch_add(buffer.fill, std::memory_order_relaxed);
+        buffer.published.store(++buffer.written, std::memory_order_release);
+        buffer.fill = 0;
+        if (buffer.written - buffer.flushed.load(std::memory_order_acquire) >= RING_BLOCKS) {
+            if (!wait) return;
+            stalls.fetch_add(1, std::memory_order_relaxed);
+            flushSignal.notify_one();
+            while (buffer.written - buffer.flushed.load(std::memory_order_acquire) >= RING_BLOCKS) {
+                std::this_thread::yield();
+            }
+        } else if (buffer.written - buffer.flushed.load(std::memory_order_relaxed) >= RING_BLOCKS / 2) {
+            flushSignal.notify_one();
+        }
+    }
+
+    void flushLoop() {
+        std::unique_lock<std::mutex> lock(flushMutex);
+        for (;;) {
+            bool last = stopping;
+            // Buffers are only added under the lock, and never removed, so copy the list and write
+            // without holding it
+            std::vector<ThreadBuffer*> current;
+            for (auto &buffer : buffers) {
+                current.push_back(buffer.get());
+            }
+            lock.unlock();
+            for (ThreadBuffer *buffer : current) {
+                size_t done = buffer->flushed.load(std::memory_order_relaxed);
+                size_t ready = buffer->published.load(std::memory_order_acquire);
+                for (; done < ready; done++) {
+                    const BlockInfo &info = buffer->info[done % RING_BLOCKS];
+                    TraceBlockHeader header = {TRACE_BLOCK_MAGIC, buffer->thread, info.count, 0, info.startNs};
+                    if (std::fwrite(&header, sizeof(header), 1, file) != 1 ||
+                        std::fwrite(buffer->blocks[done % RING_BLOCKS].events, sizeof(TraceEvent), info.count, file) != info.count) {
+                        failed = true;
+                    }
+                    buffer->flushed.store(done + 1, std::memory_order_release);
+                }
+            }
+            lock.lock();
+            if (last) return;
+            flushSignal.wait_for(lock, std::chrono::milliseconds(2));
+        }
+    }
+};
+
+#endif
@@ -0,0 +1,220 @@
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <string>
+#include <queue>
+#include <filesystem>
+#include <algorithm>
+#include <cstdio>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include "search_trace.h"
+
+// Converts a binary search trace into JSON the app can load a piece at a time:
+//   <out>/index.json         event count, kinds, and the time range of every chunk
+//   <out>/nodes.json         node names, indexed by node number
+//   <out>/chunk-00000.json   {"events": [[timeNs, thread, kind, node, parent, cost], ...]}, ...
+// Events of all threads are merged into time order. Only the block index (one entry per 4096
+// events) and one block per thread are held in memory, so traces of any size convert.
+
+// Location of one block in the trace file
+struct BlockRef {
+    uint64_t offset;   // Of the first event
+    uint64_t startNs;
+    uint32_t count;
+};
+
+// Reads the blocks of one thread in order, one block in memory at a time
+struct ThreadCursor {
+    std::vector<BlockRef> blocks;
+    size_t block = 0;
+    size_t index = 0;
+    std::vector<TraceEvent> events;
+
+    bool load(FILE *file) {
+        while (block < blocks.size()) {
+            const BlockRef &ref = blocks[block];
+            events.resize(ref.count);
+            if (std::fseek(file, static_cast<long>(ref.offset), SEEK_SET) != 0 ||
+                std::fread(events.data(), sizeof(TraceEvent), ref.count, file) != ref.count) {
+                return false;
+            }
+            index = 0;
+            if (ref.count) return true;
+            block++;
+        }
+        return true;
+    }
+
+    bool done() const {
+        return block >= blocks.size();
+    }
+
+    uint64_t time() const {
+        return blocks[block].startNs + events[index].time();
+    }
+};
+
+void writeJsonString(std::ostream &out, const std::string &text) {
+    out << '"';
+    for (unsigned char c : text) {
+        if (c == '"' || c == '\\') {
+            out << '\\' << c;
+        } else if (c < 0x20) {
+            char escaped[8];
+            std::snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+            out << escaped;
+        } else {
+            out << c;
+        }
+    }
+    out << '"';
+}
+
+int main(int argc, char *argv[]) {
+    if (argc < 3) {
+        std::cout << "Usage: trace_to_json <trace file> <output directory> [events per chunk]\n";
+        return 1;
+    }
+    std::string tracePath = argv[1];
+    std::filesystem::path outDir = argv[2];
+    size_t chunkEvents = argc > 3 ? std::strtoull(argv[3], nullptr, 10) : 50000;
+    if (chunkEvents == 0) chunkEvents = 50000;
+
+    FILE *file = std::fopen(tracePath.c_str(), "rb");
+    if (!file) {
+        std::cout << "Cannot open " << tracePath << ".\n";
+        return 1;
+    }
+    TraceFileHeader header;
+    TraceFileFooter footer;
+    if (std::fread(&header, sizeof(header), 1, file) != 1 || std::memcmp(header.magic, "STRACE1", 8) != 0 ||
+        header.eventSize != sizeof(TraceEvent) || std::fseek(file, -static_cast<long>(sizeof(footer)), SEEK_END) != 0 ||
+        std::fread(&footer, sizeof(footer), 1, file) != 1 || std::memcmp(footer.magic, "STRACEZ", 8) != 0) {
+        std::cout << tracePath << " is not a complete search trace.\n";
+        return 1;
+    }
+
+    // Index the blocks of every thread
+    std::vector<ThreadCursor> threads;
+    uint64_t offset = sizeof(header);
+    uint64_t totalEvents = 0;
+    std::fseek(file, static_cast<long>(offset), SEEK_SET);
+    while (offset < footer.namesOffset) {
+        TraceBlockHeader block;
+        if (std::fread(&block, sizeof(block), 1, file) != 1 || block.magic != TRACE_BLOCK_MAGIC) {
+            std::cout << "Corrupt block at offset " << offset << ".\n";
+            return 1;
+        }
+        offset += sizeof(block);
+        if (block.thread >= threads.size()) threads.resize(block.thread + 1);
+        threads[block.thread].blocks.push_back({offset, block.startNs, block.count});
+        offset += static_cast<uint64_t>(block.count) * sizeof(TraceEvent);
+        totalEvents += block.count;
+        std::fseek(file, static_cast<long>(offset), SEEK_SET);
+    }
+    for (auto &thread : threads) {
+        // Blocks of one thread are flushed in order, but sort anyway in case of a future change
+        std::stable_sort(thread.blocks.begin(), thread.blocks.end(),
+                         [](const BlockRef &a, const BlockRef &b) { return a.startNs < b.startNs; });
+    }
+
+    std::error_code error;
+    std::filesystem::create_directories(outDir, error);
+    if (error) {
+        std::cout << "Cannot create " << outDir << ": " << error.message() << "\n";
+        return 1;
+    }
+
+    // Node names
+    {
+        std::fseek(file, static_cast<long>(footer.namesOffset), SEEK_SET);
+        uint32_t count = 0;
+        if (std::fread(&count, sizeof(count), 1, file) != 1) count = 0;
+        std::vector<std::string> names(count);
+        for (uint32_t i = 0; i < count; i++) {
+            uint32_t node, length;
+            if (std::fread(&node, sizeof(node), 1, file) != 1 || std::fread(&length, sizeof(length), 1, file) != 1) break;
+            std::string name(length, '\0');
+            if (length && std::fread(&name[0], 1, length, file) != length) break;
+            if (node < count) names[node] = std::move(name);
+        }
+        std::ofstream nodes(outDir / "nodes.json");
+        nodes << "[";
+        for (uint32_t i = 0; i < count; i++) {
+            if (i) nodes << ",";
+            writeJsonString(nodes, names[i]);
+        }
+        nodes << "]\n";
+    }
+
+    // Merge the threads by time and cut the stream into chunks
+    typedef std::pair<uint64_t, size_t> Head; // (time, thread)
+    std::priority_queue<Head, std::vector<Head>, std::greater<Head>> heads;
+    for (size_t t = 0; t < threads.size(); t++) {
+        if (!threads[t].load(file)) {
+            std::cout << "Cannot read trace events.\n";
+            return 1;
+        }
+        if (!threads[t].done()) heads.push({threads[t].time(), t});
+    }
+
+    std::ofstream index(outDir / "index.json");
+    index << "{\"version\":1,\"events\":" << totalEvents << ",\"threads\":" << threads.size()
+          << ",\"kinds\":[\"expand\",\"push\",\"prune\",\"goal\"],\"fields\":[\"timeNs\",\"thread\",\"kind\",\"node\",\"parent\",\"cost\"]"
+          << ",\"nodes\":\"nodes.json\",\"chunks\":[";
+
+    size_t chunk = 0;
+    size_t inChunk = 0;
+    uint64_t emitted = 0;
+    uint64_t chunkStart = 0, chunkEnd = 0;
+    std::ofstream out;
+    auto finishChunk = [&]() {
+        out << "]}\n";
+        out.close();
+        char name[32];
+        std::snprintf(name, sizeof(name), "chunk-%05zu.json", chunk);
+        index << (chunk ? "," : "") << "{\"file\":\"" << name << "\",\"firstEvent\":" << emitted - inChunk
+              << ",\"events\":" << inChunk << ",\"startNs\":" << chunkStart << ",\"endNs\":" << chunkEnd << "}";
+        chunk++;
+        inChunk = 0;
+    };
+
+    while (!heads.empty()) {
+        auto [time, t] = heads.top();
+        heads.pop();
+        ThreadCursor &cursor = threads[t];
+        const TraceEvent &event = cursor.events[cursor.index];
+
+        if (inChunk == 0) {
+            char name[32];
+            std::snprintf(name, sizeof(name), "chunk-%05zu.json", chunk);
+            out.open(outDir / name);
+            out << "{\"events\":[";
+            chunkStart = time;
+        }
+        out << (inChunk ? ",[" : "[") << time << "," << t << "," << event.kind() << "," << event.node << ","
+            << (event.parent == TRACE_NO_NODE ? -1 : static_cast<long long>(event.parent)) << "," << event.cost << "]";
+        chunkEnd = time;
+        inChunk++;
+        emitted++;
+        if (inChunk == chunkEvents) finishChunk();
+
+        if (++cursor.index == cursor.events.size()) {
+            cursor.block++;
+            if (!cursor.load(file)) {
+                std::cout << "Cannot read trace events.\n";
+                return 1;
+            }
+        }
+        if (!cursor.done()) heads.push({cursor.time(), t});
+    }
+    if (inChunk) finishChunk();
+    index << "]}\n";
+    std::fclose(file);
+
+    std::cout << "Wrote " << emitted << " events from " << threads.size() << " threads in " << chunk
+              << " chunks to " << outDir.string() << std::endl;
+    return 0;
+}
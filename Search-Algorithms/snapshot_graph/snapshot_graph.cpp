@@ -0,0 +1,212 @@
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <string>
+#include <queue>
+#include <atomic>
+#include <thread>
+#include <chrono>
+#include <random>
+#include <algorithm>
+#include <functional>
+#include <cstdlib>  // For system()
+#include <limits>   // For std::numeric_limits
+#include "snapshot_graph.h"
+
+const long long INF = std::numeric_limits<long long>::max();
+
+// Export one snapshot to a DOT file for Graphviz visualization
+void exportSnapshotToDot(const GraphSnapshot &graph, const std::string &filename) {
+    std::ofstream dotFile;
+    dotFile.open(filename);
+
+    dotFile << "graph G {\n";
+    for (size_t node = 0; node < graph.nodeCount(); node++) {
+        for (const auto &edge : graph.edges(static_cast<int>(node))) {
+            if (static_cast<int>(node) <= edge.target) { // Avoid double printing edges in undirected graph
+                dotFile << "  " << graph.name(static_cast<int>(node)) << " -- " << graph.name(edge.target)
+                        << " [label=\"" << edge.weight << "\"];\n";
+            }
+        }
+    }
+    dotFile << "}\n";
+    dotFile.close();
+
+    std::cout << "Graph exported to " << filename << " successfully." << std::endl;
+}
+
+// Dijkstra on one pinned snapshot; fills path with node ids (empty if unreachable)
+long long shortestPath(const GraphSnapshot &graph, int source, int destination, std::vector<int> &path) {
+    size_t n = graph.nodeCount();
+    std::vector<long long> distance(n, INF);
+    std::vector<int> parent(n, -1);
+    std::priority_queue<std::pair<long long, int>, std::vector<std::pair<long long, int>>, std::greater<>> pq;
+    distance[source] = 0;
+    pq.push({0, source});
+    path.clear();
+
+    while (!pq.empty()) {
+        auto [d, node] = pq.top();
+        pq.pop();
+        if (d > distance[node]) continue;
+        if (node == destination) break;
+        for (const auto &edge : graph.edges(node)) {
+            if (d + edge.weight < distance[edge.target]) {
+                distance[edge.target] = d + edge.weight;
+                parent[edge.target] = node;
+                pq.push({distance[edge.target], edge.target});
+            }
+        }
+    }
+
+    if (distance[destination] == INF) return INF;
+    for (int node = destination; node != -1; node = parent[node]) {
+        path.push_back(node);
+    }
+    std::reverse(path.begin(), path.end());
+    return distance[destination];
+}
+
+// Queries per second from numReaders threads over `seconds`. With `writing`, one writer thread
+// publishes a batch of 64 random weight changes (and edge removals/reinsertions) every millisecond.
+double measureThroughput(SnapshotGraph &graph, int side, int numReaders, double seconds, bool writing,
+                         uint64_t &versionsPublished) {
+    std::atomic<bool> stop{false};
+    std::atomic<unsigned long long> queries{0};
+    uint64_t startVersion = graph.version();
+    auto name = [side](int node) { return "n" + std::to_string(node / side) + "_" + std::to_string(node % side); };
+
+    std::vector<std::thread> readers;
+    for (int t = 0; t < numReaders; t++) {
+        readers.emplace_back([&, t] {
+            std::mt19937 rng(t + 1);
+            std::vector<int> path;
+            unsigned long long done = 0;
+            while (!stop.load(std::memory_order_relaxed)) {
+                auto snapshot = graph.pin();
+                int nodes = static_cast<int>(snapshot->nodeCount());
+                shortestPath(*snapshot, rng() % nodes, rng() % nodes, path);
+                done++;
+            }
+            queries += done;
+        });
+    }
+
+    std::thread writer;
+    if (writing) {
+        writer = std::thread([&] {
+            std::mt19937 rng(12345);
+            GraphBatch batch;
+            while (!stop.load(std::memory_order_relaxed)) {
+                batch.clear();
+                for (int i = 0; i < 64; i++) {
+                    int row = rng() % side, col = rng() % (side - 1);
+                    std::string a = name(row * side + col), b = name(row * side + col + 1);
+                    if (i % 8 == 0) {
+                        batch.removeEdge(a, b);
+                        batch.insertEdge(a, b, 1 + rng() % 100);
+                    } else {
+                        batch.setWeight(a, b, 1 + rng() % 100);
+                    }
+                }
+                graph.apply(batch);
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+        });
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    std::this_thread::sleep_for(std::chrono::duration<double>(seconds));
+    stop = true;
+    for (auto &reader : readers) {
+        reader.join();
+    }
+    if (writer.joinable()) writer.join();
+    double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    versionsPublished = graph.version() - startVersion;
+    return queries / elapsed;
+}
+
+int main() {
+    SnapshotGraph graph;
+
+    // Define the relationships (edges between variables) with weights, published as one version
+    GraphBatch batch;
+    batch.insertEdge("A", "B", 4);
+    batch.insertEdge("A", "C", 2);
+    batch.insertEdge("B", "D", 5);
+    batch.insertEdge("C", "D", 8);
+    batch.insertEdge("C", "E", 10);
+    batch.insertEdge("D", "E", 2);
+    batch.insertEdge("D", "F", 6);
+    batch.insertEdge("E", "F", 3);
+    graph.apply(batch);
+
+    // Export the graph to a DOT file for Graphviz visualization
+    std::string dotFilename = "graph_output.dot";
+    exportSnapshotToDot(*graph.pin(), dotFilename);
+
+    // Use Graphviz to generate a PNG image of the graph
+    std::string graphImage = "graph_output.png";
+    std::string dotCommand = "dot -Tpng " + dotFilename + " -o " + graphImage;
+    system(dotCommand.c_str());  // Execute the dot command to generate the PNG image
+
+    // Open the PNG image using the default image viewer
+    #if defined(_WIN32) || defined(_WIN64)
+        system(("start " + graphImage).c_str()); // Windows
+    #elif defined(__APPLE__)
+        system(("open " + graphImage).c_str());  // macOS
+    #else
+        system(("xdg-open " + graphImage).c_str());  // Linux
+    #endif
+
+    // Now ask the user for source and destination
+    std::string source, destination;
+
+    std::cout << "Enter the source node: ";
+    std::getline(std::cin, source);
+    std::cout << "Enter the destination node: ";
+    std::getline(std::cin, destination);
+
+    {
+        auto snapshot = graph.pin();
+        int from = snapshot->id(source), to = snapshot->id(destination);
+        std::vector<int> path;
+        long long cost = from < 0 || to < 0 ? INF : shortestPath(*snapshot, from, to, path);
+        if (cost == INF) {
+            std::cout << "No path found from " << source << " to " << destination << ".\n";
+        } else {
+            std::cout << "Path found with cost " << cost << " in version " << snapshot->version() << ": ";
+            for (int node : path) {
+                std::cout << snapshot->name(node) << " -> ";
+            }
+            std::cout << "END" << std::endl;
+        }
+    }
+
+    // Query throughput on a grid, first on a static graph, then while a writer keeps publishing
+    const int side = 100;
+    SnapshotGraph grid;
+    GraphBatch gridBatch;
+    std::mt19937 rng(7);
+    for (int row = 0; row < side; row++) {
+        for (int col = 0; col < side; col++) {
+            std::string here = "n" + std::to_string(row) + "_" + std::to_string(col);
+            if (col + 1 < side) gridBatch.insertEdge(here, "n" + std::to_string(row) + "_" + std::to_string(col + 1), 1 + rng() % 100);
+            if (row + 1 < side) gridBatch.insertEdge(here, "n" + std::to_string(row + 1) + "_" + std::to_string(col), 1 + rng() % 100);
+        }
+    }
+    grid.apply(gridBatch);
+
+    int numReaders = std::max(1, static_cast<int>(std::thread::hardware_concurrency()) - 1);
+    uint64_t versions = 0;
+    double quiet = measureThroughput(grid, side, numReaders, 2.0, false, versions);
+    double busy = measureThroughput(grid, side, numReaders, 2.0, true, versions);
+    std::cout << side * side << "-node grid, " << numReaders << " reader threads:\n"
+              << "  no updates:   " << static_cast<long long>(quiet) << " queries/s\n"
+              << "  with updates: " << static_cast<long long>(busy) << " queries/s, " << versions
+              << " versions published (" << versions * 64 << " edge updates), " << grid.reclaimedCount()
+              << " old versions reclaimed, " << grid.retiredCount() << " still pinned" << std::endl;
+
+    return 0;
+}
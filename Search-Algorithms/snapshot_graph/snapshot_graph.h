@@ -0,0 +1,336 @@
+#ifndef SNAPSHOT_GRAPH_H
+#define SNAPSHOT_GRAPH_H
+
+#include <atomic>
+#include <mutex>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <thread>
+#include <functional>
+#include <algorithm>
+#include <utility>
+#include <cstdint>
+#include <cstddef>
+
+// Edge of a snapshot graph: neighbour id and weight
+struct SnapshotEdge {
+    int32_t target;
+    int32_t weight;
+};
+
+typedef std::vector<SnapshotEdge> SnapshotEdgeList;
+
+// One immutable version of the graph.
+//
+// Adjacency lists are grouped in pages of PAGE_SIZE nodes, and both pages and lists are shared
+// between versions: a batch that touches k nodes copies those k lists, their pages and the page
+// table, and shares everything else with the previous version. The name table is shared until
+// a batch adds a node. Nothing in a published snapshot is ever modified.
+class GraphSnapshot {
+public:
+    static const int PAGE_BITS = 8;
+    static const int PAGE_SIZE = 1 << PAGE_BITS;
+
+    uint64_t version() const {
+        return graphVersion;
+    }
+
+    size_t nodeCount() const {
+        return names->names.size();
+    }
+
+    // Node id for a name, -1 if the node does not exist (never inserts, unlike adjList[name])
+    int id(const std::string &name) const {
+        auto it = names->ids.find(name);
+        return it == names->ids.end() ? -1 : it->second;
+    }
+
+    const std::string &name(int node) const {
+        return names->names[node];
+    }
+
+    const SnapshotEdgeList &edges(int node) const {
+        const SnapshotEdgeList *list = pages[node >> PAGE_BITS]->lists[node & (PAGE_SIZE - 1)].get();
+        return list ? *list : emptyList();
+    }
+
+private:
+    friend class SnapshotGraph;
+
+    struct Page {
+        std::shared_ptr<const SnapshotEdgeList> lists[PAGE_SIZE];
+    };
+
+    struct NameTable {
+        std::vector<std::string> names;
+        std::unordered_map<std::string, int> ids;
+    };
+
+    uint64_t graphVersion = 0;
+    std::vector<std::shared_ptr<const Page>> pages;
+    std::shared_ptr<const NameTable> names = std::make_shared<const NameTable>();
+
+    static const SnapshotEdgeList &emptyList() {
+        static const SnapshotEdgeList empty;
+        return empty;
+    }
+};
+
+// Edge inserts, deletes and weight changes that are published together as one new version.
+// Edges are undirected, as in the other graphs of this repository.
+class GraphBatch {
+public:
+    void insertEdge(const std::string &var1, const std::string &var2, int weight) {
+        ops.push_back({INSERT, var1, var2, weight});
+    }
+
+    // Remove every var1 -- var2 edge (nothing happens if either node does not exist)
+    void removeEdge(const std::string &var1, const std::string &var2) {
+        ops.push_back({REMOVE, var1, var2, 0});
+    }
+
+    // Set the weight of every var1 -- var2 edge (nothing happens if either node does not exist)
+    void setWeight(const std::string &var1, const std::string &var2, int weight) {
+        ops.push_back({SET_WEIGHT, var1, var2, weight});
+    }
+
+    size_t size() const {
+        return ops.size();
+    }
+
+    void clear() {
+        ops.clear();
+    }
+
+private:
+    friend class SnapshotGraph;
+
+    enum Kind { INSERT, REMOVE, SET_WEIGHT };
+
+    struct Op {
+        Kind kind;
+        std::string var1, var2;
+        int weight;
+    };
+
+    std::vector<Op> ops;
+};
+
+// Graph that readers search without locks while writers update it.
+//
+// The current version is an atomic pointer to an immutable GraphSnapshot. A reader pins it
+// (pin()), searches it as long as it likes and unpins it by dropping the guard. A writer applies
+// a batch to a copy-on-write copy of the current version under a writer mutex and publishes the
+// result with one atomic store, so a reader sees either all of a batch or none of it.
+//
+// Old versions are reclaimed by epochs: a pinned reader announces the global epoch in a slot;
+// every publish retires the old version with the current epoch and advances it. A retired
+// version is freed once no slot announces an epoch at or below its retirement epoch, since any
+// reader that pinned it must have announced such an epoch first. Readers never block writers
+// and writers never wait for readers; reclamation simply happens at a later publish.
+class SnapshotGraph {
+public:
+    class Pin;
+
+    SnapshotGraph() {
+        current.store(new GraphSnapshot());
+    }
+
+    ~SnapshotGraph() {
+        delete current.load();
+        for (auto &retired : retiredList) {
+            delete retired.second;
+        }
+    }
+
+    SnapshotGraph(const SnapshotGraph &) = delete;
+    SnapshotGraph &operator=(const SnapshotGraph &) = delete;
+
+    // Pin the current version for reading. The snapshot stays valid while the Pin exists.
+    Pin pin();
+
+    // Apply a batch and publish it as a new version. Returns the new version number.
+    uint64_t apply(const GraphBatch &batch) {
+        std::lock_guard<std::mutex> lock(writerMutex);
+        const GraphSnapshot *old = current.load();
+        GraphSnapshot *next = new GraphSnapshot(*old); // Shares every page, list and the name table
+        next->graphVersion = old->graphVersion + 1;
+
+        // Copy each touched list once, apply all ops to the copies, then install them
+        std::unordered_map<int, SnapshotEdgeList> touched;
+        std::shared_ptr<GraphSnapshot::NameTable> newNames;
+        auto nodeId = [&](const std::string &name) {
+            int id = next->id(name);
+            if (id >= 0) return id;
+            if (!newNames) {
+                newNames = std::make_shared<GraphSnapshot::NameTable>(*next->names);
+                next->names = newNames;
+            }
+            id = static_cast<int>(newNames->names.size());
+            newNames->names.push_back(name);
+            newNames->ids.emplace(name, id);
+            if (static_cast<size_t>(id) >= next->pages.size() * GraphSnapshot::PAGE_SIZE) {
+                next->pages.push_back(std::make_shared<const GraphSnapshot::Page>());
+            }
+            return id;
+        };
+        auto list = [&](int node) -> SnapshotEdgeList & {
+            auto it = touched.find(node);
+            if (it == touched.end()) it = touched.emplace(node, next->edges(node)).first;
+            return it->second;
+        };
+
+        for (const auto &op : batch.ops) {
+            // Only inserts create nodes; removing or reweighting an edge of an unknown node does nothing
+            int a, b;
+            if (op.kind == GraphBatch::INSERT) {
+                a = nodeId(op.var1);
+                b = nodeId(op.var2);
+            } else {
+                a = next->id(op.var1);
+                b = next->id(op.var2);
+                if (a < 0 || b < 0) continue;
+            }
+            for (int side = 0; side < 2; side++) {
+                SnapshotEdgeList &edges = list(side ? b : a);
+                int other = side ? a : b;
+                if (op.kind == GraphBatch::INSERT) {
+                    edges.push_back({other, op.weight});
+                } else if (op.kind == GraphBatch::REMOVE) {
+                    edges.erase(std::remove_if(edges.begin(), edges.end(),
+                                               [&](const SnapshotEdge &e) { return e.target == other; }),
+                                edges.end());
+                } else {
+                    for (auto &edge : edges) {
+                        if (edge.target == other) edge.weight = op.weight;
+                    }
+                }
+                if (a == b) break; // A self-loop is one list entry, not two
+            }
+        }
+
+        // Copy each touched page once and point it at the new lists
+        std::unordered_map<size_t, std::shared_ptr<GraphSnapshot::Page>> newPages;
+        for (auto &entry : touched) {
+            size_t pageIndex = entry.first >> GraphSnapshot::PAGE_BITS;
+            auto &page = newPages[pageIndex];
+            if (!page) page = std::make_shared<GraphSnapshot::Page>(*next->pages[pageIndex]);
+            page->lists[entry.first & (GraphSnapshot::PAGE_SIZE - 1)] =
+                std::make_shared<const SnapshotEdgeList>(std::move(entry.second));
+        }
+        for (auto &entry : newPages) {
+            next->pages[entry.first] = std::move(entry.second);
+        }
+
+        current.store(next);
+        retiredList.push_back({epoch.fetch_add(1), old});
+        reclaim();
+        return next->graphVersion;
+    }
+
+    // Version number of the newest snapshot
+    uint64_t version() const {
+        return current.load()->graphVersion;
+    }
+
+    // Versions retired but not yet freed because a reader may still hold them
+    size_t retiredCount() {
+        std::lock_guard<std::mutex> lock(writerMutex);
+        return retiredList.size();
+    }
+
+    uint64_t reclaimedCount() const {
+        return reclaimed.load(std::memory_order_relaxed);
+    }
+
+private:
+    static const int READER_SLOTS = 128;
+    static const uint64_t IDLE = 0;
+
+    // Each slot on its own cache line, so readers pinning at the same time do not false-share
+    struct alignas(64) Slot {
+        std::atomic<uint64_t> epoch{IDLE};
+    };
+
+    std::atomic<const GraphSnapshot*> current{nullptr};
+    std::atomic<uint64_t> epoch{1};
+    Slot slots[READER_SLOTS];
+    std::mutex writerMutex;
+    std::vector<std::pair<uint64_t, const GraphSnapshot*>> retiredList; // (retirement epoch, version)
+    std::atomic<uint64_t> reclaimed{0};
+
+    // Free retired versions that no pinned reader can see (writer mutex held)
+    void reclaim() {
+        uint64_t oldest = UINT64_MAX;
+        for (const auto &slot : slots) {
+            uint64_t announced = slot.epoch.load();
+            if (announced != IDLE) oldest = std::min(oldest, announced);
+        }
+        auto kept = std::remove_if(retiredList.begin(), retiredList.end(),
+                                   [&](const std::pair<uint64_t, const GraphSnapshot*> &retired) {
+            if (retired.first >= oldest) return false;
+            delete retired.second;
+            reclaimed.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        });
+        retiredList.erase(kept, retiredList.end());
+    }
+
+    // Claim a free slot, starting from one picked by thread id so threads usually get their own
+    int claimSlot(uint64_t announced) {
+        thread_local size_t start = std::hash<std::thread::id>()(std::this_thread::get_id());
+        for (size_t i = 0;; i++) {
+            Slot &slot = slots[(start + i) % READER_SLOTS];
+            uint64_t idle = IDLE;
+            if (slot.epoch.load(std::memory_order_relaxed) == IDLE && slot.epoch.compare_exchange_strong(idle, announced)) {
+                return static_cast<int>((start + i) % READER_SLOTS);
+            }
+            if (i % READER_SLOTS == READER_SLOTS - 1) std::this_thread::yield(); // All slots busy
+        }
+    }
+};
+
+// A pinned snapshot: readable without locks until the Pin is destroyed
+class SnapshotGraph::Pin {
+public:
+    Pin(Pin &&other) noexcept : graph(other.graph), slot(other.slot), snapshot(other.snapshot) {
+        other.graph = nullptr;
+    }
+
+    Pin(const Pin &) = delete;
+    Pin &operator=(const Pin &) = delete;
+    Pin &operator=(Pin &&) = delete;
+
+    ~Pin() {
+        if (graph) graph->slots[slot].epoch.store(IDLE, std::memory_order_release);
+    }
+
+    const GraphSnapshot &operator*() const {
+        return *snapshot;
+    }
+
+    const GraphSnapshot *operator->() const {
+        return snapshot;
+    }
+
+private:
+    friend class SnapshotGraph;
+
+    SnapshotGraph *graph;
+    int slot;
+    const GraphSnapshot *snapshot;
+
+    Pin(SnapshotGraph *graph, int slot, const GraphSnapshot *snapshot)
+        : graph(graph), slot(slot), snapshot(snapshot) {}
+};
+
+inline SnapshotGraph::Pin SnapshotGraph::pin() {
+    // Announce the epoch before loading the pointer (both sequentially consistent): a writer that
+    // retires this version afterwards will see the announcement when it reclaims
+    int slot = claimSlot(epoch.load());
+    return Pin(this, slot, current.load());
+}
+
+#endif